@@ -22,6 +22,7 @@ namespace arc
 		Array<T>& operator=(Array<T>&& other);
 	public:
 		ARC_NO_COPY(Array);
+		using TriviallyRelocatable = std::true_type;
 	public:
 		T& operator[] (uint32 idx);
 		const T& operator[] (uint32 idx) const;
@@ -78,12 +78,18 @@ namespace arc
 	{
 		if (m_capacity > m_size)
 		{
+			// give the tail back without moving
+			if (m_data != nullptr && m_allocator->try_expand_in_place(m_data, m_capacity*sizeof(T), m_size*sizeof(T)))
+			{
+				m_capacity = m_size;
+				return;
+			}
+
 			// allocate new memory
 			auto newData = m_allocator->allocate(m_size*sizeof(T), alignof(T));
-			// move to new memory
-			memory::util::move_construct_elements<T>(m_data, newData, m_size);
+			// move to new memory and destroy the old elements
+			memory::util::relocate_elements<T>(m_data, newData, m_size);
 			// free old memory
-			memory::util::delete_elements<T>(m_data, m_size);
 			m_allocator->free(m_data);
 			// book keeping
 			m_data = (T*)newData;
@@ -100,13 +106,27 @@ namespace arc
 		// respect requested minimum capacity
 		if (minCapacity > nextCapacity) nextCapacity = minCapacity;
 
-		// allocate new memory
-		auto newData = m_allocator->allocate(nextCapacity*sizeof(T), alignof(T));
-		// move data to new memory
-		memory::util::move_construct_elements<T>(m_data, newData, m_size);
-		// delete old data and free
-		memory::util::delete_elements<T>(m_data, m_size);
-		m_allocator->free(m_data);
+		// grow without moving if the allocator can
+		if (m_data != nullptr && m_allocator->try_expand_in_place(m_data, m_capacity*sizeof(T), nextCapacity*sizeof(T)))
+		{
+			m_capacity = nextCapacity;
+			return;
+		}
+
+		void* newData = nullptr;
+		if (is_trivially_relocatable<T>::value)
+		{
+			// the allocator moves the memory, no per element work
+			newData = m_allocator->reallocate(m_data, m_capacity*sizeof(T), nextCapacity*sizeof(T), alignof(T));
+		}
+		else
+		{
+			// allocate new memory
+			newData = m_allocator->allocate(nextCapacity*sizeof(T), alignof(T));
+			// move data to new memory and destroy the old elements
+			memory::util::relocate_elements<T>(m_data, newData, m_size);
+			m_allocator->free(m_data);
+		}
 		// book keeping
 		m_data = (T*)newData;
 		m_capacity = nextCapacity;
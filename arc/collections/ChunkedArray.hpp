@@ -0,0 +1,76 @@
+#pragma once
+
+#include "arc/core.hpp"
+#include "arc/collections/Array.hpp"
+#include "arc/collections/Slice.hpp"
+
+namespace arc
+{
+	/* Array of fixed size chunks holding CHUNK_SIZE elements each, CHUNK_SIZE is a power of two.
+	 * Growing adds chunks and never moves elements, so pointers to elements stay valid until
+	 * the element is removed. An index maps to its chunk with a shift and a mask. Loops over
+	 * chunk(i) see contiguous memory, only the chunk pointers are chased. */
+	template<typename T, uint32 CHUNK_SIZE = 64>
+	class ChunkedArray
+	{
+		static_assert(CHUNK_SIZE != 0 && (CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0, "CHUNK_SIZE must be a power of two");
+	public:
+		ChunkedArray(memory::Allocator& a);
+		ChunkedArray() = default;
+		~ChunkedArray();
+	public: // move constructor and assignment
+		ChunkedArray(ChunkedArray<T, CHUNK_SIZE>&& other);
+		ChunkedArray<T, CHUNK_SIZE>& operator=(ChunkedArray<T, CHUNK_SIZE>&& other);
+	public:
+		ARC_NO_COPY(ChunkedArray);
+		using TriviallyRelocatable = std::true_type;
+	public:
+		T& operator[] (uint32 idx);
+		const T& operator[] (uint32 idx) const;
+
+	public:
+		uint32 size() const;
+		uint32 capacity() const;
+		bool empty() const;
+
+	public:
+		void push_back(const T& value = T());
+		void push_back(T&& value);
+
+		void pop_back();
+		T& back();
+		const T& back() const;
+
+		/// Moves the last element into idx and removes the last slot, O(1).
+		void swap_remove(uint32 idx);
+
+	public:
+		template<typename ...Args>
+		void emplace_back(Args&& ...args);
+
+	public:
+		void reserve(uint32 size);
+		void trim();
+		void clear();
+
+	public: // chunk wise access, all chunks but the last one are full
+		uint32 chunk_count() const;
+		Slice<T> chunk(uint32 chunk_idx);
+		const Slice<T> chunk(uint32 chunk_idx) const;
+
+	public:
+		void initialize(memory::Allocator* alloc);
+		void finalize();
+		bool is_initialized();
+
+	private:
+		T* slot(uint32 idx) const;
+		void add_slot();
+
+	private:
+		memory::Allocator* m_allocator = nullptr;
+		Array<T*>          m_chunks;
+		uint32             m_size = 0;
+	};
+
+} // namespace arc
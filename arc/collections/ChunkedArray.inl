@@ -0,0 +1,230 @@
+#pragma once
+
+#include "ChunkedArray.hpp"
+
+#include "arc/collections/Array.inl"
+#include "arc/memory/Allocator.hpp"
+#include "arc/memory/util.hpp"
+
+namespace arc
+{
+	namespace chunked_array
+	{
+		template<uint32 N> struct Log2 { static const uint32 value = 1 + Log2<N / 2>::value; };
+		template<> struct Log2<1> { static const uint32 value = 0; };
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	ChunkedArray<T, CHUNK_SIZE>::ChunkedArray(memory::Allocator& a)
+	{
+		initialize(&a);
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	ChunkedArray<T, CHUNK_SIZE>::~ChunkedArray()
+	{
+		finalize();
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	ChunkedArray<T, CHUNK_SIZE>::ChunkedArray(ChunkedArray<T, CHUNK_SIZE>&& other)
+		: m_allocator(other.m_allocator)
+		, m_chunks(std::move(other.m_chunks))
+		, m_size(other.m_size)
+	{
+		other.m_allocator = nullptr;
+		other.m_size = 0;
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	ChunkedArray<T, CHUNK_SIZE>& ChunkedArray<T, CHUNK_SIZE>::operator=(ChunkedArray<T, CHUNK_SIZE>&& other)
+	{
+		if (this == &other) return *this;
+		finalize();
+
+		m_allocator = other.m_allocator;
+		m_chunks = std::move(other.m_chunks);
+		m_size = other.m_size;
+
+		other.m_allocator = nullptr;
+		other.m_size = 0;
+		return *this;
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	void ChunkedArray<T, CHUNK_SIZE>::initialize(memory::Allocator* alloc)
+	{
+		finalize();
+
+		m_allocator = alloc;
+		m_chunks.initialize(alloc);
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	void ChunkedArray<T, CHUNK_SIZE>::finalize()
+	{
+		if (is_initialized())
+		{
+			clear();
+			for (auto chunk : m_chunks) m_allocator->free(chunk);
+			m_chunks.finalize();
+			m_allocator = nullptr;
+		}
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	bool ChunkedArray<T, CHUNK_SIZE>::is_initialized()
+	{
+		return m_allocator != nullptr;
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	T* ChunkedArray<T, CHUNK_SIZE>::slot(uint32 idx) const
+	{
+		return m_chunks[idx >> chunked_array::Log2<CHUNK_SIZE>::value] + (idx & (CHUNK_SIZE - 1));
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	void ChunkedArray<T, CHUNK_SIZE>::add_slot()
+	{
+		if (m_size == capacity())
+		{
+			m_chunks.push_back((T*)m_allocator->allocate(CHUNK_SIZE * sizeof(T), alignof(T)));
+		}
+		m_size += 1;
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	T& ChunkedArray<T, CHUNK_SIZE>::operator[](uint32 idx)
+	{
+		return *slot(idx);
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	const T& ChunkedArray<T, CHUNK_SIZE>::operator[](uint32 idx) const
+	{
+		return *slot(idx);
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	uint32 ChunkedArray<T, CHUNK_SIZE>::size() const
+	{
+		return m_size;
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	uint32 ChunkedArray<T, CHUNK_SIZE>::capacity() const
+	{
+		return m_chunks.size() * CHUNK_SIZE;
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	bool ChunkedArray<T, CHUNK_SIZE>::empty() const
+	{
+		return m_size == 0;
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	void ChunkedArray<T, CHUNK_SIZE>::push_back(const T& value)
+	{
+		add_slot();
+		new (&back()) T(value);
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	void ChunkedArray<T, CHUNK_SIZE>::push_back(T&& value)
+	{
+		add_slot();
+		new (&back()) T(std::move(value));
+	}
+
+	template<typename T, uint32 CHUNK_SIZE>
+	template<typename ...Args> inline
+	void ChunkedArray<T, CHUNK_SIZE>::emplace_back(Args&& ...args)
+	{
+		add_slot();
+		new (&back()) T(std::forward<Args>(args)...);
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	void ChunkedArray<T, CHUNK_SIZE>::pop_back()
+	{
+		ARC_ASSERT(size() > 0, "Called pop_back() on empty ChunkedArray");
+		memory::util::delete_elements<T>(&back(), 1);
+		m_size -= 1;
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	T& ChunkedArray<T, CHUNK_SIZE>::back()
+	{
+		return *slot(m_size - 1);
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	const T& ChunkedArray<T, CHUNK_SIZE>::back() const
+	{
+		return *slot(m_size - 1);
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	void ChunkedArray<T, CHUNK_SIZE>::swap_remove(uint32 idx)
+	{
+		ARC_ASSERT(idx < size(), "ChunkedArray index out of range");
+		if (idx != m_size - 1) (*this)[idx] = std::move(back());
+		pop_back();
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	void ChunkedArray<T, CHUNK_SIZE>::reserve(uint32 size)
+	{
+		while (capacity() < size)
+		{
+			m_chunks.push_back((T*)m_allocator->allocate(CHUNK_SIZE * sizeof(T), alignof(T)));
+		}
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	void ChunkedArray<T, CHUNK_SIZE>::trim()
+	{
+		// chunks behind the last element hold nothing
+		while (capacity() >= m_size + CHUNK_SIZE)
+		{
+			m_allocator->free(m_chunks.back());
+			m_chunks.pop_back();
+		}
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	void ChunkedArray<T, CHUNK_SIZE>::clear()
+	{
+		for (uint32 c = 0; c < chunk_count(); c++)
+		{
+			auto elements = chunk(c);
+			memory::util::delete_elements<T>(elements.ptr(), (uint32)elements.size());
+		}
+		m_size = 0;
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	uint32 ChunkedArray<T, CHUNK_SIZE>::chunk_count() const
+	{
+		return (m_size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	Slice<T> ChunkedArray<T, CHUNK_SIZE>::chunk(uint32 chunk_idx)
+	{
+		uint32 first = chunk_idx * CHUNK_SIZE;
+		uint32 n = m_size - first < CHUNK_SIZE ? m_size - first : CHUNK_SIZE;
+		return Slice<T>(m_chunks[chunk_idx], n);
+	}
+
+	template<typename T, uint32 CHUNK_SIZE> inline
+	const Slice<T> ChunkedArray<T, CHUNK_SIZE>::chunk(uint32 chunk_idx) const
+	{
+		uint32 first = chunk_idx * CHUNK_SIZE;
+		uint32 n = m_size - first < CHUNK_SIZE ? m_size - first : CHUNK_SIZE;
+		return Slice<T>(m_chunks[chunk_idx], n);
+	}
+
+} // namespace arc
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "arc/core.hpp"
+#include "arc/memory/Allocator.hpp"
+#include "arc/collections/Array.hpp"
+
+namespace arc
+{
+	/* Hash map with uint64 keys for tables that are read from many threads and rarely written.
+	 *
+	 * Readers never lock or write shared memory: a lookup loads the current table and probes it
+	 * linearly, so it finishes in a bounded number of steps even while a writer is active.
+	 * Writers are serialized by a mutex. Values are immutable once published, setting a key
+	 * publishes a new copy and growing publishes a new table, the replaced ones are retired.
+	 * Readers may still see retired values and tables, so they are only freed by collect(),
+	 * which has to run while no reader is inside the map (e.g. between frames). Pointers
+	 * returned by lookup() stay valid until then.
+	 *
+	 * The key ~0 is reserved to mark empty slots. */
+	template<typename T>
+	class ConcurrentHashMap
+	{
+	public:
+		ConcurrentHashMap();
+		ConcurrentHashMap(memory::Allocator& alloc);
+		~ConcurrentHashMap();
+	public:
+		ARC_NO_COPY(ConcurrentHashMap);
+	public:
+		void initialize(memory::Allocator* alloc);
+		void finalize();
+		bool is_initialized() const;
+
+	public: // readers, any thread
+		const T* lookup(uint64 key) const;
+		bool contains(uint64 key) const;
+		uint32 size() const;
+
+	public: // writers, any thread, one at a time
+		/// Returns true if key was not present before.
+		bool set(uint64 key, const T& value);
+		bool remove(uint64 key);
+		void reserve(uint32 size);
+
+		/// Frees the values and tables replaced since the last call.
+		/// No reader may run concurrently and no pointer from lookup() may be used afterwards.
+		void collect();
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint64> key;			// EMPTY_KEY until claimed, never changes afterwards
+			std::atomic<T*>     value;			// nullptr if removed
+		};
+		struct Table
+		{
+			uint32 mask;
+			uint32 used;						// claimed slots, including removed ones
+
+			Slot* slots() { return reinterpret_cast<Slot*>(this + 1); }
+			const Slot* slots() const { return reinterpret_cast<const Slot*>(this + 1); }
+		};
+	private:
+		Slot& claim_slot(Table* table, uint64 key);
+		void  rehash(uint32 min_capacity);
+
+	private:
+		memory::Allocator*  m_alloc = nullptr;
+		std::atomic<Table*> m_table;
+		std::atomic<uint32> m_size;
+
+		std::mutex    m_write_mutex;
+		Array<T*>     m_retired_values;
+		Array<Table*> m_retired_tables;
+
+	private:
+		static const uint64 EMPTY_KEY = ~0ULL;
+	};
+
+} // namespace arc
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "ConcurrentHashMap.hpp"
+
+#include "arc/core.hpp"
+#include "arc/hash/mix.hpp"
+#include "arc/memory/Allocator.hpp"
+#include "arc/collections/Array.inl"
+
+namespace arc
+{
+	template<typename T>
+	ConcurrentHashMap<T>::ConcurrentHashMap()
+		: m_table(nullptr), m_size(0)
+	{}
+
+	template<typename T>
+	ConcurrentHashMap<T>::ConcurrentHashMap(memory::Allocator& alloc)
+		: m_table(nullptr), m_size(0)
+	{
+		initialize(&alloc);
+	}
+
+	template<typename T>
+	ConcurrentHashMap<T>::~ConcurrentHashMap()
+	{
+		finalize();
+	}
+
+	template<typename T>
+	void ConcurrentHashMap<T>::initialize(memory::Allocator* alloc)
+	{
+		finalize();
+
+		m_alloc = alloc;
+		m_retired_values.initialize(alloc);
+		m_retired_tables.initialize(alloc);
+	}
+
+	template<typename T>
+	void ConcurrentHashMap<T>::finalize()
+	{
+		if (is_initialized())
+		{
+			collect();
+
+			Table* table = m_table.load(std::memory_order_relaxed);
+			if (table != nullptr)
+			{
+				for (uint32 i = 0; i <= table->mask; i++)
+				{
+					T* value = table->slots()[i].value.load(std::memory_order_relaxed);
+					if (value != nullptr) m_alloc->destroy(value);
+				}
+				m_alloc->free(table);
+			}
+
+			m_table.store(nullptr, std::memory_order_relaxed);
+			m_size.store(0, std::memory_order_relaxed);
+			m_retired_values.finalize();
+			m_retired_tables.finalize();
+			m_alloc = nullptr;
+		}
+	}
+
+	template<typename T>
+	bool ConcurrentHashMap<T>::is_initialized() const
+	{
+		return m_alloc != nullptr;
+	}
+
+	template<typename T>
+	const T* ConcurrentHashMap<T>::lookup(uint64 key) const
+	{
+		const Table* table = m_table.load(std::memory_order_acquire);
+		if (table == nullptr) return nullptr;
+
+		// a key without value was removed or is still being set
+		auto slots = table->slots();
+		uint32 idx = (uint32)hash::mix64(key) & table->mask;
+		for (uint32 probe = 0; probe <= table->mask; probe++)
+		{
+			uint64 k = slots[idx].key.load(std::memory_order_acquire);
+			if (k == key) return slots[idx].value.load(std::memory_order_acquire);
+			if (k == EMPTY_KEY) return nullptr;
+			idx = (idx + 1) & table->mask;
+		}
+		return nullptr;
+	}
+
+	template<typename T>
+	bool ConcurrentHashMap<T>::contains(uint64 key) const
+	{
+		return lookup(key) != nullptr;
+	}
+
+	template<typename T>
+	uint32 ConcurrentHashMap<T>::size() const
+	{
+		return m_size.load(std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	bool ConcurrentHashMap<T>::set(uint64 key, const T& value)
+	{
+		ARC_ASSERT(key != EMPTY_KEY, "The key ~0 is reserved by ConcurrentHashMap");
+		std::lock_guard<std::mutex> lock(m_write_mutex);
+
+		// keep at least half of the slots empty, so probe sequences stay short
+		Table* table = m_table.load(std::memory_order_relaxed);
+		if (table == nullptr || (table->used + 1) * 2 > table->mask + 1)
+		{
+			rehash((size() + 1) * 4);
+			table = m_table.load(std::memory_order_relaxed);
+		}
+
+		T* copy = m_alloc->create<T>(value);
+		Slot& slot = claim_slot(table, key);
+		T* old = slot.value.exchange(copy, std::memory_order_release);
+		if (old != nullptr)
+		{
+			m_retired_values.push_back(old);
+			return false;
+		}
+
+		m_size.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	template<typename T>
+	bool ConcurrentHashMap<T>::remove(uint64 key)
+	{
+		std::lock_guard<std::mutex> lock(m_write_mutex);
+
+		// the key keeps its slot, probe sequences running through it stay intact
+		const T* found = lookup(key);
+		if (found == nullptr) return false;
+
+		Table* table = m_table.load(std::memory_order_relaxed);
+		T* old = claim_slot(table, key).value.exchange(nullptr, std::memory_order_release);
+		m_retired_values.push_back(old);
+		m_size.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	template<typename T>
+	void ConcurrentHashMap<T>::reserve(uint32 size)
+	{
+		std::lock_guard<std::mutex> lock(m_write_mutex);
+
+		Table* table = m_table.load(std::memory_order_relaxed);
+		if (table == nullptr || table->mask + 1 < size * 2) rehash(size * 2);
+	}
+
+	template<typename T>
+	void ConcurrentHashMap<T>::collect()
+	{
+		std::lock_guard<std::mutex> lock(m_write_mutex);
+
+		for (auto value : m_retired_values) m_alloc->destroy(value);
+		for (auto table : m_retired_tables) m_alloc->free(table);
+		m_retired_values.clear();
+		m_retired_tables.clear();
+	}
+
+	template<typename T>
+	typename ConcurrentHashMap<T>::Slot& ConcurrentHashMap<T>::claim_slot(Table* table, uint64 key)
+	{
+		// only called by writers, so the slot found empty can't be claimed by anyone else
+		auto slots = table->slots();
+		uint32 idx = (uint32)hash::mix64(key) & table->mask;
+		for (;;)
+		{
+			uint64 k = slots[idx].key.load(std::memory_order_relaxed);
+			if (k == key) return slots[idx];
+			if (k == EMPTY_KEY)
+			{
+				// readers finding the key before set() stores its value treat it as absent
+				slots[idx].value.store(nullptr, std::memory_order_relaxed);
+				slots[idx].key.store(key, std::memory_order_release);
+				table->used++;
+				return slots[idx];
+			}
+			idx = (idx + 1) & table->mask;
+		}
+	}
+
+	template<typename T>
+	void ConcurrentHashMap<T>::rehash(uint32 min_capacity)
+	{
+		uint32 capacity = 8;
+		while (capacity < min_capacity) capacity *= 2;
+
+		Table* table = (Table*)m_alloc->allocate(sizeof(Table) + capacity * sizeof(Slot), alignof(Slot));
+		table->mask = capacity - 1;
+		table->used = 0;
+		for (uint32 i = 0; i < capacity; i++)
+		{
+			new (&table->slots()[i].key) std::atomic<uint64>(EMPTY_KEY);
+			new (&table->slots()[i].value) std::atomic<T*>(nullptr);
+		}
+
+		// the values move over by pointer, removed keys are dropped
+		Table* old = m_table.load(std::memory_order_relaxed);
+		if (old != nullptr)
+		{
+			for (uint32 i = 0; i <= old->mask; i++)
+			{
+				T* value = old->slots()[i].value.load(std::memory_order_relaxed);
+				if (value == nullptr) continue;
+
+				uint64 key = old->slots()[i].key.load(std::memory_order_relaxed);
+				claim_slot(table, key).value.store(value, std::memory_order_relaxed);
+			}
+			m_retired_tables.push_back(old);
+		}
+
+		// publishes the filled table, readers holding the old one can keep using it
+		m_table.store(table, std::memory_order_release);
+	}
+
+} // namespace arc
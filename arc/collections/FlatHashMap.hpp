@@ -0,0 +1,211 @@
+#pragma once
+
+#include <cstring>
+
+#include "arc/core.hpp"
+#include "arc/core/bits.hpp"
+#include "arc/memory/Allocator.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define ARC_FLAT_HASH_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+	#define ARC_FLAT_HASH_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace arc
+{
+	namespace flat_hash
+	{
+		// control bytes, full slots store the lower 7 bits of the hash
+		static const int8 EMPTY = -128;
+		static const int8 DELETED = -2;
+
+		/* One bit per matching control byte, BIT_SHIFT converts bit to byte positions. */
+		template<uint32 BIT_SHIFT>
+		struct BitMask
+		{
+			uint64 mask;
+
+			explicit operator bool() const { return mask != 0; }
+			uint32 lowest() const { return bits::trailing_zeros(mask) >> BIT_SHIFT; }
+			void clear_lowest() { mask &= mask - 1; }
+		};
+
+		/* Control bytes of WIDTH consecutive slots, compared in parallel. */
+#if defined(ARC_FLAT_HASH_SSE2)
+		struct Group
+		{
+			static const uint32 WIDTH = 16;
+			using Mask = BitMask<0>;
+
+			explicit Group(const int8* ctrl) : m_ctrl(_mm_loadu_si128((const __m128i*)ctrl)) {}
+
+			Mask match(int8 h2) const
+			{
+				return Mask{ (uint64)(uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)) };
+			}
+			Mask match_empty() const { return match(EMPTY); }
+			Mask match_free() const { return Mask{ (uint64)(uint32)_mm_movemask_epi8(m_ctrl) }; }
+
+			__m128i m_ctrl;
+		};
+#elif defined(ARC_FLAT_HASH_NEON)
+		struct Group
+		{
+			static const uint32 WIDTH = 16;
+			using Mask = BitMask<2>;
+
+			explicit Group(const int8* ctrl) : m_ctrl(vld1q_s8(ctrl)) {}
+
+			// narrows each byte of the comparison to a nibble, keeps one bit per nibble
+			static Mask to_mask(uint8x16_t cmp)
+			{
+				uint8x8_t narrow = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+				return Mask{ vget_lane_u64(vreinterpret_u64_u8(narrow), 0) & 0x8888888888888888ULL };
+			}
+
+			Mask match(int8 h2) const { return to_mask(vceqq_s8(m_ctrl, vdupq_n_s8(h2))); }
+			Mask match_empty() const { return match(EMPTY); }
+			Mask match_free() const { return to_mask(vcltq_s8(m_ctrl, vdupq_n_s8(0))); }
+
+			int8x16_t m_ctrl;
+		};
+#else
+		// portable fallback working on 8 bytes at once, assumes little endian
+		struct Group
+		{
+			static const uint32 WIDTH = 8;
+			using Mask = BitMask<3>;
+
+			static const uint64 LSBS = 0x0101010101010101ULL;
+			static const uint64 MSBS = 0x8080808080808080ULL;
+
+			explicit Group(const int8* ctrl) { std::memcpy(&m_ctrl, ctrl, sizeof(m_ctrl)); }
+
+			// may report false positives, callers compare the keys anyway
+			Mask match(int8 h2) const
+			{
+				uint64 x = m_ctrl ^ (LSBS * (uint8)h2);
+				return Mask{ (x - LSBS) & ~x & MSBS };
+			}
+			Mask match_empty() const { return Mask{ m_ctrl & ~(m_ctrl << 6) & MSBS }; }
+			Mask match_free() const { return Mask{ m_ctrl & MSBS }; }
+
+			uint64 m_ctrl;
+		};
+#endif
+	}
+
+	/// Open addressing hash map with the uint64 key interface of HashMap.
+	/// Slots are probed a group of control bytes at a time, see flat_hash::Group.
+	/// Entries stay in place when others are removed, but move when the map grows.
+	template<typename T>
+	class FlatHashMap
+	{
+	public:
+		struct Entry
+		{
+			uint64 key() const { return m_key; }
+			T& value() { return m_value; }
+			const T& value() const { return m_value; }
+		public:
+			Entry(uint64 key, const T& value) : m_key(key), m_value(value) {}
+			Entry(uint64 key, T&& value) : m_key(key), m_value(std::forward<T>(value)) {}
+			Entry(Entry&& other) : m_key(other.m_key), m_value(std::move(other.m_value)) {}
+		private:
+			uint64 m_key;
+			T      m_value;
+
+			friend class FlatHashMap<T>;
+		};
+
+		template<typename E>
+		class Iterator
+		{
+		public:
+			Iterator(const int8* ctrl, E* slot, E* end) : m_ctrl(ctrl), m_slot(slot), m_end(end) { skip_free(); }
+
+			E& operator*() const { return *m_slot; }
+			E* operator->() const { return m_slot; }
+			Iterator& operator++() { m_ctrl++; m_slot++; skip_free(); return *this; }
+			bool operator!=(const Iterator& other) const { return m_slot != other.m_slot; }
+			bool operator==(const Iterator& other) const { return m_slot == other.m_slot; }
+		private:
+			void skip_free() { while (m_slot != m_end && *m_ctrl < 0) { m_ctrl++; m_slot++; } }
+		private:
+			const int8* m_ctrl;
+			E* m_slot;
+			E* m_end;
+		};
+
+	public:
+		FlatHashMap() = default;
+		FlatHashMap(memory::Allocator& alloc);
+		~FlatHashMap();
+	public:
+		FlatHashMap(FlatHashMap<T>&& other);
+		FlatHashMap<T>& operator=(FlatHashMap<T>&& other);
+		ARC_NO_COPY(FlatHashMap);
+
+		using TriviallyRelocatable = std::true_type;
+
+	public:
+		void initialize(memory::Allocator* alloc);
+		void finalize();
+		bool is_initialized() const;
+
+	public:
+		Entry* lookup(uint64 key);
+		const Entry* lookup(uint64 key) const;
+
+		Entry& get(uint64 key, const T& fallback_init);
+		Entry& get(uint64 key, const T& fallback_init, bool& o_fallback_used);
+
+		Entry& get(uint64 key, T&& fallback_init);
+		Entry& get(uint64 key, T&& fallback_init, bool& o_fallback_used);
+
+		Entry& set(uint64 key, const T& value);
+
+	public:
+		bool remove(uint64 key);
+		bool contains(uint64 key) const;
+
+	public:
+		void reserve(uint32 size);
+		void clear();
+
+	public:
+		uint32 size() const;
+		uint32 capacity() const;
+		float  load_factor() const;
+
+	public: // range based for loop support
+		Iterator<Entry> begin();
+		Iterator<Entry> end();
+
+		Iterator<const Entry> begin() const;
+		Iterator<const Entry> end() const;
+
+	private:
+		uint32 find(uint64 key, uint64 hash) const;
+		uint32 find_free(uint64 hash) const;
+		void   set_ctrl(uint32 idx, int8 h2);
+		uint32 prepare_insert(uint64 hash);
+		void   resize(uint32 new_capacity);
+		void   release();
+
+	private:
+		memory::Allocator* m_alloc = nullptr;
+		int8*  m_ctrl = nullptr;			// m_capacity + Group::WIDTH - 1 bytes, the tail mirrors the head
+		Entry* m_slots = nullptr;
+		uint32 m_capacity = 0;				// zero or a power of two
+		uint32 m_size = 0;
+		uint32 m_growth_left = 0;			// inserts into empty slots left until the map grows
+
+	private:
+		static const uint32 END_INDEX = -1;
+	};
+
+} // namespace arc
@@ -0,0 +1,355 @@
+#pragma once
+
+#include "FlatHashMap.hpp"
+
+#include "arc/core.hpp"
+#include "arc/hash/mix.hpp"
+#include "arc/memory/util.hpp"
+
+namespace arc
+{
+	namespace flat_hash
+	{
+		inline uint64 hash_key(uint64 key) { return hash::mix64(key); }
+		inline uint32 h1(uint64 hash) { return (uint32)(hash >> 7); }
+		inline int8   h2(uint64 hash) { return (int8)(hash & 0x7F); }
+
+		// a map keeps at least one slot in eight free, so that every probe sequence ends
+		inline uint32 max_load(uint32 capacity) { return capacity - capacity / 8; }
+	}
+
+	template<typename T> inline
+	FlatHashMap<T>::FlatHashMap(memory::Allocator& alloc)
+		: m_alloc(&alloc)
+	{}
+
+	template<typename T> inline
+	FlatHashMap<T>::~FlatHashMap()
+	{
+		release();
+	}
+
+	template<typename T> inline
+	FlatHashMap<T>::FlatHashMap(FlatHashMap<T>&& other)
+		: m_alloc(other.m_alloc)
+		, m_ctrl(other.m_ctrl)
+		, m_slots(other.m_slots)
+		, m_capacity(other.m_capacity)
+		, m_size(other.m_size)
+		, m_growth_left(other.m_growth_left)
+	{
+		other.m_ctrl = nullptr;
+		other.m_slots = nullptr;
+		other.m_capacity = other.m_size = other.m_growth_left = 0;
+	}
+
+	template<typename T> inline
+	FlatHashMap<T>& FlatHashMap<T>::operator=(FlatHashMap<T>&& other)
+	{
+		if (this == &other) return *this;
+		release();
+
+		m_alloc = other.m_alloc;
+		m_ctrl = other.m_ctrl;
+		m_slots = other.m_slots;
+		m_capacity = other.m_capacity;
+		m_size = other.m_size;
+		m_growth_left = other.m_growth_left;
+
+		other.m_ctrl = nullptr;
+		other.m_slots = nullptr;
+		other.m_capacity = other.m_size = other.m_growth_left = 0;
+		return *this;
+	}
+
+	template<typename T> inline
+	void FlatHashMap<T>::initialize(memory::Allocator* alloc)
+	{
+		release();
+		m_alloc = alloc;
+	}
+
+	template<typename T> inline
+	void FlatHashMap<T>::finalize()
+	{
+		release();
+		m_alloc = nullptr;
+	}
+
+	template<typename T> inline
+	bool FlatHashMap<T>::is_initialized() const
+	{
+		return m_alloc != nullptr;
+	}
+
+	template<typename T> inline
+	uint32 FlatHashMap<T>::find(uint64 key, uint64 hash) const
+	{
+		// empty hash map case
+		if (m_capacity == 0) return END_INDEX;
+
+		uint32 mask = m_capacity - 1;
+		uint32 pos = flat_hash::h1(hash) & mask;
+		int8 h2 = flat_hash::h2(hash);
+
+		// triangular probing over groups visits every group once
+		for (uint32 step = flat_hash::Group::WIDTH; ; step += flat_hash::Group::WIDTH)
+		{
+			flat_hash::Group group(m_ctrl + pos);
+			for (auto match = group.match(h2); match; match.clear_lowest())
+			{
+				uint32 idx = (pos + match.lowest()) & mask;
+				if (m_slots[idx].m_key == key) return idx;
+			}
+			if (group.match_empty()) return END_INDEX;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	template<typename T> inline
+	uint32 FlatHashMap<T>::find_free(uint64 hash) const
+	{
+		uint32 mask = m_capacity - 1;
+		uint32 pos = flat_hash::h1(hash) & mask;
+
+		for (uint32 step = flat_hash::Group::WIDTH; ; step += flat_hash::Group::WIDTH)
+		{
+			auto free = flat_hash::Group(m_ctrl + pos).match_free();
+			if (free) return (pos + free.lowest()) & mask;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	template<typename T> inline
+	void FlatHashMap<T>::set_ctrl(uint32 idx, int8 h2)
+	{
+		m_ctrl[idx] = h2;
+		// keep the mirrored tail in sync, groups starting near the end read it
+		if (idx < flat_hash::Group::WIDTH - 1) m_ctrl[m_capacity + idx] = h2;
+	}
+
+	template<typename T> inline
+	uint32 FlatHashMap<T>::prepare_insert(uint64 hash)
+	{
+		uint32 idx = m_capacity == 0 ? END_INDEX : find_free(hash);
+
+		// reusing a deleted slot does not use up an empty one
+		if (idx == END_INDEX || (m_growth_left == 0 && m_ctrl[idx] == flat_hash::EMPTY))
+		{
+			// drop tombstones in place if the map is less than half full, grow otherwise
+			uint32 capacity = m_capacity == 0 ? flat_hash::Group::WIDTH : m_capacity;
+			if (m_size >= flat_hash::max_load(capacity) / 2) capacity *= 2;
+			resize(capacity);
+			idx = find_free(hash);
+		}
+
+		if (m_ctrl[idx] == flat_hash::EMPTY) m_growth_left--;
+		set_ctrl(idx, flat_hash::h2(hash));
+		m_size++;
+		return idx;
+	}
+
+	template<typename T> inline
+	void FlatHashMap<T>::resize(uint32 new_capacity)
+	{
+		ARC_ASSERT(new_capacity >= flat_hash::Group::WIDTH, "FlatHashMap: capacity below group width");
+
+		auto old_ctrl = m_ctrl;
+		auto old_slots = m_slots;
+		auto old_capacity = m_capacity;
+
+		// control bytes and slots share one allocation
+		uint64 ctrl_size = memory::util::forward_align((uint64)new_capacity + flat_hash::Group::WIDTH - 1, (uint64)alignof(Entry));
+		uint32 align = alignof(Entry) > 16 ? (uint32)alignof(Entry) : 16;
+		auto data = (char*)m_alloc->allocate(ctrl_size + sizeof(Entry) * (uint64)new_capacity, align);
+
+		m_ctrl = (int8*)data;
+		m_slots = (Entry*)(data + ctrl_size);
+		m_capacity = new_capacity;
+		m_growth_left = flat_hash::max_load(new_capacity) - m_size;
+		std::memset(m_ctrl, (uint8)flat_hash::EMPTY, new_capacity + flat_hash::Group::WIDTH - 1);
+
+		if (old_ctrl == nullptr) return;
+
+		// reinsert values, no key can be present twice
+		for (uint32 i = 0; i < old_capacity; i++)
+		{
+			if (old_ctrl[i] < 0) continue;
+
+			auto& entry = old_slots[i];
+			uint64 hash = flat_hash::hash_key(entry.m_key);
+			uint32 idx = find_free(hash);
+			set_ctrl(idx, flat_hash::h2(hash));
+			new (&m_slots[idx]) Entry(std::move(entry));
+			entry.~Entry();
+		}
+
+		m_alloc->free(old_ctrl);
+	}
+
+	template<typename T> inline
+	void FlatHashMap<T>::release()
+	{
+		if (m_ctrl == nullptr) return;
+
+		clear();
+		m_alloc->free(m_ctrl);
+		m_ctrl = nullptr;
+		m_slots = nullptr;
+		m_capacity = 0;
+		m_growth_left = 0;
+	}
+
+	template<typename T> inline
+	typename FlatHashMap<T>::Entry* FlatHashMap<T>::lookup(uint64 key)
+	{
+		uint32 idx = find(key, flat_hash::hash_key(key));
+		return idx == END_INDEX ? nullptr : &m_slots[idx];
+	}
+
+	template<typename T> inline
+	const typename FlatHashMap<T>::Entry* FlatHashMap<T>::lookup(uint64 key) const
+	{
+		uint32 idx = find(key, flat_hash::hash_key(key));
+		return idx == END_INDEX ? nullptr : &m_slots[idx];
+	}
+
+	template<typename T> inline
+	typename FlatHashMap<T>::Entry& FlatHashMap<T>::get(uint64 key, const T& fallback_init)
+	{
+		bool fallback_used;
+		return get(key, fallback_init, fallback_used);
+	}
+
+	template<typename T> inline
+	typename FlatHashMap<T>::Entry& FlatHashMap<T>::get(uint64 key, const T& fallback_init, bool& o_fallback_used)
+	{
+		uint64 hash = flat_hash::hash_key(key);
+		uint32 idx = find(key, hash);
+
+		o_fallback_used = idx == END_INDEX;
+		if (o_fallback_used)
+		{
+			idx = prepare_insert(hash);
+			new (&m_slots[idx]) Entry(key, fallback_init);
+		}
+		return m_slots[idx];
+	}
+
+	template<typename T> inline
+	typename FlatHashMap<T>::Entry& FlatHashMap<T>::get(uint64 key, T&& fallback_init)
+	{
+		bool fallback_used;
+		return get(key, std::forward<T>(fallback_init), fallback_used);
+	}
+
+	template<typename T> inline
+	typename FlatHashMap<T>::Entry& FlatHashMap<T>::get(uint64 key, T&& fallback_init, bool& o_fallback_used)
+	{
+		uint64 hash = flat_hash::hash_key(key);
+		uint32 idx = find(key, hash);
+
+		o_fallback_used = idx == END_INDEX;
+		if (o_fallback_used)
+		{
+			idx = prepare_insert(hash);
+			new (&m_slots[idx]) Entry(key, std::forward<T>(fallback_init));
+		}
+		return m_slots[idx];
+	}
+
+	template<typename T> inline
+	typename FlatHashMap<T>::Entry& FlatHashMap<T>::set(uint64 key, const T& value)
+	{
+		bool inserted;
+		auto& entry = get(key, value, inserted);
+		if (!inserted) entry.m_value = value;
+		return entry;
+	}
+
+	template<typename T> inline
+	bool FlatHashMap<T>::remove(uint64 key)
+	{
+		uint32 idx = find(key, flat_hash::hash_key(key));
+
+		// no such entry present
+		if (idx == END_INDEX) return false;
+
+		// the slot may be part of other probe sequences, so it can't become empty again
+		m_slots[idx].~Entry();
+		set_ctrl(idx, flat_hash::DELETED);
+		m_size--;
+		return true;
+	}
+
+	template<typename T> inline
+	bool FlatHashMap<T>::contains(uint64 key) const
+	{
+		return find(key, flat_hash::hash_key(key)) != END_INDEX;
+	}
+
+	template<typename T> inline
+	void FlatHashMap<T>::reserve(uint32 size)
+	{
+		uint32 capacity = flat_hash::Group::WIDTH;
+		while (flat_hash::max_load(capacity) < size) capacity *= 2;
+		if (capacity > m_capacity) resize(capacity);
+	}
+
+	template<typename T> inline
+	void FlatHashMap<T>::clear()
+	{
+		if (m_capacity == 0) return;
+
+		for (uint32 i = 0; i < m_capacity; i++)
+		{
+			if (m_ctrl[i] >= 0) m_slots[i].~Entry();
+		}
+		std::memset(m_ctrl, (uint8)flat_hash::EMPTY, m_capacity + flat_hash::Group::WIDTH - 1);
+		m_size = 0;
+		m_growth_left = flat_hash::max_load(m_capacity);
+	}
+
+	template<typename T> inline
+	uint32 FlatHashMap<T>::size() const
+	{
+		return m_size;
+	}
+
+	template<typename T> inline
+	uint32 FlatHashMap<T>::capacity() const
+	{
+		return m_capacity;
+	}
+
+	template<typename T> inline
+	float FlatHashMap<T>::load_factor() const
+	{
+		return m_capacity == 0 ? 0 : float(m_size) / float(m_capacity);
+	}
+
+	template<typename T> inline
+	typename FlatHashMap<T>::template Iterator<typename FlatHashMap<T>::Entry> FlatHashMap<T>::begin()
+	{
+		return Iterator<Entry>(m_ctrl, m_slots, m_slots + m_capacity);
+	}
+
+	template<typename T> inline
+	typename FlatHashMap<T>::template Iterator<typename FlatHashMap<T>::Entry> FlatHashMap<T>::end()
+	{
+		return Iterator<Entry>(m_ctrl + m_capacity, m_slots + m_capacity, m_slots + m_capacity);
+	}
+
+	template<typename T> inline
+	typename FlatHashMap<T>::template Iterator<const typename FlatHashMap<T>::Entry> FlatHashMap<T>::begin() const
+	{
+		return Iterator<const Entry>(m_ctrl, m_slots, m_slots + m_capacity);
+	}
+
+	template<typename T> inline
+	typename FlatHashMap<T>::template Iterator<const typename FlatHashMap<T>::Entry> FlatHashMap<T>::end() const
+	{
+		return Iterator<const Entry>(m_ctrl + m_capacity, m_slots + m_capacity, m_slots + m_capacity);
+	}
+
+} // namespace arc
@@ -2,81 +2,140 @@
 
 #include "arc/core/numeric_types.hpp"
 #include "arc/collections/Array.hpp"
+#include "arc/hash/Hasher.hpp"
 
 namespace arc
 {
+	namespace hash_map
+	{
+		/// Key of an entry, together with its hash if the hasher caches it. A cached hash is
+		/// compared before the keys, so most of the key compares in a chain are skipped.
+		template<typename K, typename H, bool CACHE = H::CACHE_HASH>
+		struct StoredKey
+		{
+			StoredKey() : m_key(), m_hash(0) {}
+			StoredKey(const K& key, uint64 hash) : m_key(key), m_hash(hash) {}
+
+			uint64 hash() const { return m_hash; }
+			template<typename Q>
+			bool matches(const Q& key, uint64 hash) const { return m_hash == hash && H::equal(m_key, key); }
+
+			K      m_key;
+			uint64 m_hash;
+		};
+
+		template<typename K, typename H>
+		struct StoredKey<K, H, false>
+		{
+			StoredKey() : m_key() {}
+			StoredKey(const K& key, uint64) : m_key(key) {}
+
+			uint64 hash() const { return H::hash(m_key); }
+			template<typename Q>
+			bool matches(const Q& key, uint64) const { return H::equal(m_key, key); }
+
+			K m_key;
+		};
+	}
 
 	/// HashMap implementation
 	/// based on: https://bitbucket.org/bitsquid/foundation
-	template<typename T>
+	/// Keys are hashed with H, see Hasher. Lookups take any key type H can hash and compare,
+	/// e.g. a StringView for String keys. HashMap<uint64, V> uses its keys as hashes directly.
+	template<typename K, typename V, typename H = Hasher<K>>
 	class HashMap
 	{
 	public:
 		struct Entry
 		{
-			uint64 key() { return m_key; }
-			T& value() { return m_value; }
-			const T& value() const { return m_value; }
+			const K& key() const { return m_key.m_key; }
+			V& value() { return m_value; }
+			const V& value() const { return m_value; }
 		public:
-			Entry(uint64_t key, const T& value, uint32_t next = 0)
-				: m_key(key), m_value(value), m_next(next)
+			Entry(const K& key, uint64 hash, const V& value, uint32_t next = 0)
+				: m_key(key, hash), m_value(value), m_next(next)
 			{}
 
-			Entry(uint64_t key, T&& value, uint32_t next = 0)
-				: m_key(key), m_value(std::forward<T>(value)), m_next(next)
+			Entry(const K& key, uint64 hash, V&& value, uint32_t next = 0)
+				: m_key(key, hash), m_value(std::forward<V>(value)), m_next(next)
 			{}
 
-			Entry() : m_key(0), m_value(), m_next(0) {}
+			Entry() : m_key(), m_value(), m_next(0) {}
 		public:
 			Entry(Entry&& other)
-				: m_key(other.m_key), m_value(std::move(other.m_value)), m_next(other.m_next)
+				: m_key(std::move(other.m_key)), m_value(std::move(other.m_value)), m_next(other.m_next)
 			{}
 
 			Entry& operator=(Entry&& other)
 			{
-				m_key = other.m_key;
+				m_key = std::move(other.m_key);
 				m_value = std::move(other.m_value);
 				m_next = other.m_next;
 				return *this;
 			}
 
 		private:
-			uint64 m_key;
-			T      m_value;
+			hash_map::StoredKey<K, H> m_key;
+			V      m_value;
 			uint32 m_next; 
 
-			friend class HashMap<T>;
+			friend class HashMap<K, V, H>;
+		public:
+			using TriviallyRelocatable = std::integral_constant<bool,
+				is_trivially_relocatable<K>::value && is_trivially_relocatable<V>::value>;
 		};
 
 	public:
 		HashMap() = default;
 		HashMap(memory::Allocator& alloc);
 
+		using TriviallyRelocatable = std::true_type;
+
 	public:
 		void initialize(memory::Allocator* alloc);
 		void finalize();
 		bool is_initialized();
 
 	public:
-		Entry* lookup(uint64 key);
-		const Entry* lookup(uint64 key) const;
+		template<typename Q>
+		Entry* lookup(const Q& key);
+		template<typename Q>
+		const Entry* lookup(const Q& key) const;
 
-		Entry& get(uint64 key, const T& fallback_init);
-		Entry& get(uint64 key, const T& fallback_init, bool& o_fallback_used);
+		Entry& get(const K& key, const V& fallback_init);
+		Entry& get(const K& key, const V& fallback_init, bool& o_fallback_used);
 
-		Entry& get(uint64 key, T&& fallback_init);
-		Entry& get(uint64 key, T&& fallback_init, bool& o_fallback_used);
+		Entry& get(const K& key, V&& fallback_init);
+		Entry& get(const K& key, V&& fallback_init, bool& o_fallback_used);
 
-		Entry& set(uint64 key, const T& value);
+		Entry& set(const K& key, const V& value);
 
 	public:
-		bool remove(uint64 key);
-		bool contains(uint64 key) const;
+		template<typename Q>
+		bool remove(const Q& key);
+		template<typename Q>
+		bool contains(const Q& key) const;
+
+	public:
+		/// Looks up all keys, o_entries[i] is nullptr if keys[i] is not present.
+		/// All buckets are prefetched before the chains are followed, so the cache misses
+		/// of the lookups overlap. Returns the number of keys found.
+		uint32 lookup_batch(Slice<const K> keys, Slice<Entry*> o_entries);
+		uint32 contains_batch(Slice<const K> keys, Slice<bool> o_contained) const;
 
 	public:
 		void reserve(uint32 size);
 		void clear();
 
+	public:
+		/// In incremental mode growing the map doesn't rebuild the index at once. The old index
+		/// is kept next to the new one and a few buckets are moved over on each insert or
+		/// remove, lookups check whichever index currently holds the key.
+		void set_incremental_rehash(bool enabled);
+		/// Moves up to budget buckets, e.g. from idle time. Returns the buckets left to move.
+		uint32 rehash_step(uint32 budget);
+		bool is_rehashing() const;
+
 	public:
 		uint32 size() const;
 		float  load_factor() const;
@@ -92,27 +151,37 @@ namespace arc
 	private:
 		struct FindResultPrev
 		{
-			uint32 h_idx;
 			uint32 d_idx;
 			uint32 prev_d_idx;
 		};
 		struct FindResult
 		{
-			uint32 h_idx;
 			uint32 d_idx;
 		};
 	private:
-		FindResultPrev find_prev(uint64 key) const;
-		FindResult find(uint64 key) const;
+		template<typename Q>
+		FindResultPrev find_prev(const Q& key, uint64 hash) const;
+		template<typename Q>
+		FindResult find(const Q& key, uint64 hash) const;
+		template<typename F>
+		uint32 find_batch(Slice<const K> keys, F on_result) const;
 		bool present(const FindResult& fr) const;
+		const uint32& bucket(uint64 hash) const;
+		uint32& bucket(uint64 hash);
 	private:
 		void rehash(uint32 new_size);
+		void grow();
 
 	private:
 		Array<uint32> m_hashes;
+		Array<uint32> m_old_hashes;			// index being migrated from, empty otherwise
 		Array<Entry>  m_data;
+		uint32 m_migrated = 0;				// buckets of m_old_hashes already moved
+		bool   m_incremental = false;
 	private:
 		static const uint32 END_INDEX = -1;
+		static const uint32 BATCH_SIZE = 16;		// lookups in flight at once
+		static const uint32 REHASH_STEP = 4;		// buckets migrated per insert or remove
 
 	};
 
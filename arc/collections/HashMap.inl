@@ -7,36 +7,43 @@
 
 namespace arc
 {
-    template<typename T>
-	HashMap<T>::HashMap(memory::Allocator &alloc)
-        : m_hashes(alloc), m_data(alloc)
+    template<typename K, typename V, typename H>
+	HashMap<K, V, H>::HashMap(memory::Allocator &alloc)
+        : m_hashes(alloc), m_old_hashes(alloc), m_data(alloc)
     {}
 
 
-	template<typename T>
-	void HashMap<T>::initialize(memory::Allocator* alloc)
+	template<typename K, typename V, typename H>
+	void HashMap<K, V, H>::initialize(memory::Allocator* alloc)
 	{
 		m_hashes.initialize(alloc);
+		m_old_hashes.initialize(alloc);
 		m_data.initialize(alloc);
 	}
 
-	template<typename T>
-	void HashMap<T>::finalize()
+	template<typename K, typename V, typename H>
+	void HashMap<K, V, H>::finalize()
 	{
 		m_hashes.finalize();
+		m_old_hashes.finalize();
 		m_data.finalize();
+		m_migrated = 0;
 	}
 
-	template<typename T>
-	bool HashMap<T>::is_initialized()
+	template<typename K, typename V, typename H>
+	bool HashMap<K, V, H>::is_initialized()
 	{
 		return m_hashes.is_initialized();
 	}
 
-    template<typename T>
-    bool HashMap<T>::remove(uint64 key)
+    template<typename K, typename V, typename H>
+    template<typename Q>
+    bool HashMap<K, V, H>::remove(const Q& key)
     {
-        auto fr = find_prev(key);
+        if (is_rehashing()) rehash_step(REHASH_STEP);
+
+        uint64 hash = H::hash(key);
+        auto fr = find_prev(key, hash);
 
         // no such entry present
         if (fr.d_idx == END_INDEX) return false;
@@ -44,7 +51,7 @@ namespace arc
         // first entry in hash collision chain
         if (fr.prev_d_idx == END_INDEX)
         {
-            m_hashes[fr.h_idx] = m_data[fr.d_idx].m_next;
+            bucket(hash) = m_data[fr.d_idx].m_next;
         }
         // later entry
         else
@@ -61,9 +68,10 @@ namespace arc
 
         // else swap last entry and entry to be removed
         // this needs some updates to the book keeping
-        auto fr2 = find_prev(m_data.back().m_key);
+        auto& last_key = m_data.back().m_key;
+        auto fr2 = find_prev(last_key.m_key, last_key.hash());
         if (fr2.prev_d_idx == END_INDEX)
-            m_hashes[fr2.h_idx] = fr.d_idx;
+            bucket(last_key.hash()) = fr.d_idx;
         else
             m_data[fr2.prev_d_idx].m_next = fr.d_idx;
 
@@ -73,95 +81,162 @@ namespace arc
         return true;
     }
 
-    template<typename T>
-    bool HashMap<T>::contains(uint64 key) const
+    template<typename K, typename V, typename H>
+    template<typename Q>
+    bool HashMap<K, V, H>::contains(const Q& key) const
     {
         return lookup(key) != nullptr;
     }
 
+    template<typename K, typename V, typename H>
+    uint32 HashMap<K, V, H>::lookup_batch(Slice<const K> keys, Slice<Entry*> o_entries)
+    {
+        ARC_ASSERT(o_entries.size() >= keys.size(), "output slice is too small");
+        return find_batch(keys, [this, &o_entries](uint64 i, uint32 d_idx)
+        {
+            o_entries[i] = d_idx == END_INDEX ? nullptr : &m_data[d_idx];
+        });
+    }
+
+    template<typename K, typename V, typename H>
+    uint32 HashMap<K, V, H>::contains_batch(Slice<const K> keys, Slice<bool> o_contained) const
+    {
+        ARC_ASSERT(o_contained.size() >= keys.size(), "output slice is too small");
+        return find_batch(keys, [&o_contained](uint64 i, uint32 d_idx)
+        {
+            o_contained[i] = d_idx != END_INDEX;
+        });
+    }
 
 
-    template<typename T>
-    typename HashMap<T>::FindResult HashMap<T>::find(uint64 key) const
+
+    template<typename K, typename V, typename H>
+    template<typename Q>
+    typename HashMap<K, V, H>::FindResult HashMap<K, V, H>::find(const Q& key, uint64 hash) const
     {
         FindResult fr;
-        fr.h_idx = END_INDEX;
         fr.d_idx = END_INDEX;
 
         // empty hash map case
         if (m_hashes.size() == 0) return fr;
 
-        // hash uint64 value
-        fr.h_idx = key % m_hashes.size();
-
         // move through the linked list of entries with hash collisions
-        fr.d_idx = m_hashes[fr.h_idx];
+        fr.d_idx = bucket(hash);
         while (fr.d_idx != END_INDEX)
         {
             auto& data = m_data[fr.d_idx];
-            if (data.m_key == key) return fr;
+            if (data.m_key.matches(key, hash)) return fr;
             fr.d_idx = data.m_next;
         }
         return fr;
     }
 
-    template<typename T>
-    typename HashMap<T>::FindResultPrev HashMap<T>::find_prev(uint64 key) const
+    template<typename K, typename V, typename H>
+    template<typename F>
+    uint32 HashMap<K, V, H>::find_batch(Slice<const K> keys, F on_result) const
+    {
+        const uint32* heads[BATCH_SIZE];
+        uint64 hashes[BATCH_SIZE];
+        uint32 d_idx[BATCH_SIZE];
+        uint32 found = 0;
+
+        for (uint64 begin = 0; begin < keys.size(); begin += BATCH_SIZE)
+        {
+            uint32 n = (uint32)(keys.size() - begin < BATCH_SIZE ? keys.size() - begin : BATCH_SIZE);
+
+            // empty hash map case
+            if (m_hashes.size() == 0)
+            {
+                for (uint32 i = 0; i < n; i++) on_result(begin + i, END_INDEX);
+                continue;
+            }
+
+            // hash all keys and fetch their buckets
+            for (uint32 i = 0; i < n; i++)
+            {
+                hashes[i] = H::hash(keys[begin + i]);
+                heads[i] = &bucket(hashes[i]);
+                memory::util::prefetch(heads[i]);
+            }
+
+            // fetch the first entry of every chain
+            for (uint32 i = 0; i < n; i++)
+            {
+                d_idx[i] = *heads[i];
+                if (d_idx[i] != END_INDEX) memory::util::prefetch(&m_data[d_idx[i]]);
+            }
+
+            // move through the linked lists of entries with hash collisions
+            for (uint32 i = 0; i < n; i++)
+            {
+                auto& key = keys[begin + i];
+                uint32 d = d_idx[i];
+                while (d != END_INDEX && !m_data[d].m_key.matches(key, hashes[i])) d = m_data[d].m_next;
+
+                if (d != END_INDEX) found++;
+                on_result(begin + i, d);
+            }
+        }
+        return found;
+    }
+
+    template<typename K, typename V, typename H>
+    template<typename Q>
+    typename HashMap<K, V, H>::FindResultPrev HashMap<K, V, H>::find_prev(const Q& key, uint64 hash) const
     {
         FindResultPrev fr;
-        fr.h_idx = END_INDEX;
         fr.d_idx = END_INDEX;
         fr.prev_d_idx = END_INDEX;
 
         // empty hash map case
         if (m_hashes.size() == 0) return fr;
 
-        // hash uint64 value
-        fr.h_idx = key % m_hashes.size();
-
         // move through the linked list of entries with hash collisions
-        fr.d_idx = m_hashes[fr.h_idx];
+        fr.d_idx = bucket(hash);
         while (fr.d_idx != END_INDEX)
         {
             auto& data = m_data[fr.d_idx];
-            if (data.m_key == key) return fr;
+            if (data.m_key.matches(key, hash)) return fr;
             fr.prev_d_idx = fr.d_idx;
             fr.d_idx = data.m_next;
         }
         return fr;
     }
 
-    template<typename T>
-    bool HashMap<T>::present(typename const HashMap<T>::FindResult& fr) const
+    template<typename K, typename V, typename H>
+    bool HashMap<K, V, H>::present(const typename HashMap<K, V, H>::FindResult& fr) const
     {
         return fr.d_idx != END_INDEX;
     }
 
-    template<typename T>
-    void HashMap<T>::reserve(uint32 size)
+    template<typename K, typename V, typename H>
+    void HashMap<K, V, H>::reserve(uint32 size)
     {
         float s = size;
         rehash((s*10.0f/7.0f)+1);
     }
 
-    template<typename T>
-    void HashMap<T>::clear()
+    template<typename K, typename V, typename H>
+    void HashMap<K, V, H>::clear()
     {
         m_hashes.clear();
+        m_old_hashes.finalize();
+        m_migrated = 0;
         m_data.clear();
     }
 
-    template<typename T>
-    uint32 HashMap<T>::size() const
+    template<typename K, typename V, typename H>
+    uint32 HashMap<K, V, H>::size() const
     {
         return m_data.size();
     }
 
 
-    template<typename T>
-	typename HashMap<T>::Entry& HashMap<T>::set(uint64 key, const T& value)
+    template<typename K, typename V, typename H>
+	typename HashMap<K, V, H>::Entry& HashMap<K, V, H>::set(const K& key, const V& value)
     {
-        auto fr = find(key);
+        uint64 hash = H::hash(key);
+        auto fr = find(key, hash);
         if (present(fr))
         {
             m_data[fr.d_idx].m_value = value;
@@ -169,31 +244,26 @@ namespace arc
         }
         else
         {
-            if (m_hashes.size() == 0)
-            {
-                rehash(8);
-                fr.h_idx = key % m_hashes.size();
-            }
-			Entry entry;
-			entry.m_key = key;
-			entry.m_value = value;
-			entry.m_next = m_hashes[fr.h_idx];
-			m_data.push_back(entry);
-
-            m_hashes[fr.h_idx] = m_data.size() - 1;
-            if (load_factor() > 0.7f) rehash(m_hashes.size()*2);
+            if (m_hashes.size() == 0) rehash(8);
+
+			auto& head = bucket(hash);
+			Entry entry(key, hash, value, head);
+			m_data.push_back(std::move(entry));
+
+            head = m_data.size() - 1;
+            grow();
 			return m_data.back();
         }
     }
 
-    template<typename T>
-    float HashMap<T>::load_factor() const
+    template<typename K, typename V, typename H>
+    float HashMap<K, V, H>::load_factor() const
     {
         return m_hashes.size() == 0 ? 0 : float(m_data.size()) / float(m_hashes.size());
     }
 
-    template<typename T>
-    uint32 HashMap<T>::collision_count() const
+    template<typename K, typename V, typename H>
+    uint32 HashMap<K, V, H>::collision_count() const
     {
         uint32 counter = 0;
         for (auto& v : m_data)
@@ -203,108 +273,190 @@ namespace arc
         return counter;
     }
 
-    template<typename T>
-    typename HashMap<T>::Entry* HashMap<T>::begin()
+    template<typename K, typename V, typename H>
+    typename HashMap<K, V, H>::Entry* HashMap<K, V, H>::begin()
     {
-        return reinterpret_cast<arc::HashMap<T>::Entry*>(arc::begin(m_data));
+        return reinterpret_cast<arc::HashMap<K, V, H>::Entry*>(arc::begin(m_data));
     }
 
-    template<typename T>
-    typename HashMap<T>::Entry* HashMap<T>::end()
+    template<typename K, typename V, typename H>
+    typename HashMap<K, V, H>::Entry* HashMap<K, V, H>::end()
     {
-        return reinterpret_cast<arc::HashMap<T>::Entry*>(arc::end(m_data));
+        return reinterpret_cast<arc::HashMap<K, V, H>::Entry*>(arc::end(m_data));
     }
 
-    template<typename T>
-    const typename HashMap<T>::Entry* HashMap<T>::begin() const
+    template<typename K, typename V, typename H>
+    const typename HashMap<K, V, H>::Entry* HashMap<K, V, H>::begin() const
     {
-        return reinterpret_cast<arc::HashMap<T>::Entry*>(arc::begin(m_data));
+        return reinterpret_cast<arc::HashMap<K, V, H>::Entry*>(arc::begin(m_data));
     }
 
-    template<typename T>
-    const typename HashMap<T>::Entry* HashMap<T>::end() const
+    template<typename K, typename V, typename H>
+    const typename HashMap<K, V, H>::Entry* HashMap<K, V, H>::end() const
     {
-        return reinterpret_cast<arc::HashMap<T>::Entry*>(arc::end(m_data));
+        return reinterpret_cast<arc::HashMap<K, V, H>::Entry*>(arc::end(m_data));
     }
 
-    template<typename T>
-    void HashMap<T>::rehash(uint32 new_size)
+    template<typename K, typename V, typename H>
+    void HashMap<K, V, H>::rehash(uint32 new_size)
     {
         ARC_ASSERT(new_size != 0, "Can't rehash to zero size");
 
+        // a pending migration is finished first
+        if (is_rehashing()) rehash_step(m_old_hashes.size());
+
         // resize hash storage
         m_hashes.resize(new_size);
         for (auto& h : m_hashes) h = END_INDEX;
-        for (auto& v : m_data) v.m_next = END_INDEX;
 
-        // reinsert values
+        // reinsert values at the front of their chains
         for (uint32 i=0; i<m_data.size(); i++)
         {
-            auto key = m_data[i].m_key;
-            auto h_idx = key % new_size;
-            if (m_hashes[(uint32)h_idx] == END_INDEX)
-            {
-				m_hashes[(uint32)h_idx] = i;
-                continue;
-            }
-			auto d_idx = m_hashes[(uint32)h_idx];
-            while (m_data[d_idx].m_next != END_INDEX)
+            auto h_idx = (uint32)(m_data[i].m_key.hash() % new_size);
+            m_data[i].m_next = m_hashes[h_idx];
+            m_hashes[h_idx] = i;
+        }
+    }
+
+    template<typename K, typename V, typename H>
+    void HashMap<K, V, H>::grow()
+    {
+        if (!m_incremental)
+        {
+            if (load_factor() > 0.7f) rehash(m_hashes.size() * 2);
+            return;
+        }
+
+        if (is_rehashing())
+        {
+            rehash_step(REHASH_STEP);
+        }
+        else if (load_factor() > 0.7f)
+        {
+            // the old index is migrated bucket by bucket, see bucket()
+            // old bucket h splits into the new buckets h and h + old size, which are only
+            // initialized once h is migrated, so growing doesn't touch the whole new index
+            m_old_hashes = std::move(m_hashes);
+            m_hashes.resize(m_old_hashes.size() * 2);
+            m_migrated = 0;
+            rehash_step(REHASH_STEP);
+        }
+    }
+
+    template<typename K, typename V, typename H>
+    uint32 HashMap<K, V, H>::rehash_step(uint32 budget)
+    {
+        if (!is_rehashing()) return 0;
+
+        uint32 end = m_old_hashes.size() - m_migrated > budget ? m_migrated + budget : m_old_hashes.size();
+        for (uint32 h_idx = m_migrated; h_idx < end; h_idx++)
+        {
+            m_hashes[h_idx] = END_INDEX;
+            m_hashes[h_idx + m_old_hashes.size()] = END_INDEX;
+
+            // move every entry of the old chain to the front of its new chain
+            auto d_idx = m_old_hashes[h_idx];
+            while (d_idx != END_INDEX)
             {
-                d_idx = m_data[d_idx].m_next;
+                auto& entry = m_data[d_idx];
+                auto next = entry.m_next;
+                auto& head = m_hashes[(uint32)(entry.m_key.hash() % m_hashes.size())];
+                entry.m_next = head;
+                head = d_idx;
+                d_idx = next;
             }
-            m_data[d_idx].m_next = i;
         }
+        m_migrated = end;
+
+        if (m_migrated == m_old_hashes.size())
+        {
+            m_old_hashes.finalize();
+            m_migrated = 0;
+        }
+        return m_old_hashes.size() - m_migrated;
+    }
+
+    template<typename K, typename V, typename H>
+    void HashMap<K, V, H>::set_incremental_rehash(bool enabled)
+    {
+        if (!enabled && is_rehashing()) rehash_step(m_old_hashes.size());
+        m_incremental = enabled;
+    }
+
+    template<typename K, typename V, typename H>
+    bool HashMap<K, V, H>::is_rehashing() const
+    {
+        return m_old_hashes.size() != 0;
     }
 
-	template<typename T>
-	typename HashMap<T>::Entry* HashMap<T>::lookup(uint64 key)
+    template<typename K, typename V, typename H>
+    const uint32& HashMap<K, V, H>::bucket(uint64 hash) const
+    {
+        // buckets of the old index below m_migrated were moved to the new one
+        if (m_old_hashes.size() != 0)
+        {
+            auto h_idx = (uint32)(hash % m_old_hashes.size());
+            if (h_idx >= m_migrated) return m_old_hashes[h_idx];
+        }
+        return m_hashes[(uint32)(hash % m_hashes.size())];
+    }
+
+    template<typename K, typename V, typename H>
+    uint32& HashMap<K, V, H>::bucket(uint64 hash)
+    {
+        return const_cast<uint32&>(static_cast<const HashMap<K, V, H>*>(this)->bucket(hash));
+    }
+
+	template<typename K, typename V, typename H>
+	template<typename Q>
+	typename HashMap<K, V, H>::Entry* HashMap<K, V, H>::lookup(const Q& key)
 	{
-		auto fr = find(key);
+		auto fr = find(key, H::hash(key));
 		if (fr.d_idx == END_INDEX)
 			return nullptr;
 		else
 			return &m_data[fr.d_idx];
 	}
 
-	template<typename T>
-	typename const HashMap<T>::Entry* HashMap<T>::lookup(uint64 key) const
+	template<typename K, typename V, typename H>
+	template<typename Q>
+	const typename HashMap<K, V, H>::Entry* HashMap<K, V, H>::lookup(const Q& key) const
 	{
-		auto fr = find(key);
+		auto fr = find(key, H::hash(key));
 		if (fr.d_idx == END_INDEX)
 			return nullptr;
 		else
 			return &m_data[fr.d_idx];
 	}
 
-	template<typename T>
-	typename HashMap<T>::Entry& HashMap<T>::get(uint64 key, T&& fallback_init)
+	template<typename K, typename V, typename H>
+	typename HashMap<K, V, H>::Entry& HashMap<K, V, H>::get(const K& key, V&& fallback_init)
 	{
-		auto fr = find(key);
+		uint64 hash = H::hash(key);
+		auto fr = find(key, hash);
 		if (present(fr))
 		{
 			return m_data[fr.d_idx];
 		}
 		else
 		{
-			if (m_hashes.size() == 0)
-			{
-				rehash(8);
-				fr.h_idx = key % m_hashes.size();
-			}
+			if (m_hashes.size() == 0) rehash(8);
 
-			Entry entry(key, std::forward<T>(fallback_init), m_hashes[fr.h_idx]);
+			auto& head = bucket(hash);
+			Entry entry(key, hash, std::forward<V>(fallback_init), head);
 			m_data.push_back(std::move(entry));
-			m_hashes[fr.h_idx] = m_data.size() - 1;
+			head = m_data.size() - 1;
 
-			if (load_factor() > 0.7f) rehash(m_hashes.size() * 2);
+			grow();
 			return m_data.back();
 		}
 	}
 
-	template<typename T>
-	typename HashMap<T>::Entry& HashMap<T>::get(uint64 key, T&& fallback_init, bool& o_fallback_used)
+	template<typename K, typename V, typename H>
+	typename HashMap<K, V, H>::Entry& HashMap<K, V, H>::get(const K& key, V&& fallback_init, bool& o_fallback_used)
 	{
-		auto fr = find(key);
+		uint64 hash = H::hash(key);
+		auto fr = find(key, hash);
 		if (present(fr))
 		{
 			o_fallback_used = false;
@@ -313,51 +465,46 @@ namespace arc
 		else
 		{
 			o_fallback_used = true;
-			if (m_hashes.size() == 0)
-			{
-				rehash(8);
-				fr.h_idx = key % m_hashes.size();
-			}
+			if (m_hashes.size() == 0) rehash(8);
 
-			Entry entry(key, std::forward<T>(fallback_init), m_hashes[fr.h_idx]);
+			auto& head = bucket(hash);
+			Entry entry(key, hash, std::forward<V>(fallback_init), head);
 			m_data.push_back(std::move(entry));
-			m_hashes[fr.h_idx] = m_data.size() - 1;
+			head = m_data.size() - 1;
 
-			if (load_factor() > 0.7f) rehash(m_hashes.size() * 2);
+			grow();
 			return m_data.back();
 		}
 	}
 
-	template<typename T>
-	typename HashMap<T>::Entry& HashMap<T>::get(uint64 key, const T& fallback_init)
+	template<typename K, typename V, typename H>
+	typename HashMap<K, V, H>::Entry& HashMap<K, V, H>::get(const K& key, const V& fallback_init)
 	{
-		auto fr = find(key);
+		uint64 hash = H::hash(key);
+		auto fr = find(key, hash);
 		if (present(fr))
 		{
 			return m_data[fr.d_idx];
 		}
 		else
 		{
-			if (m_hashes.size() == 0)
-			{
-				rehash(8);
-				fr.h_idx = key % m_hashes.size();
-			}
-
+			if (m_hashes.size() == 0) rehash(8);
 
-			Entry entry(key, fallback_init, m_hashes[fr.h_idx]);
+			auto& head = bucket(hash);
+			Entry entry(key, hash, fallback_init, head);
 			m_data.push_back(std::move(entry));
-			m_hashes[fr.h_idx] = m_data.size() - 1;
+			head = m_data.size() - 1;
 
-			if (load_factor() > 0.7f) rehash(m_hashes.size() * 2);
+			grow();
 			return m_data.back();
 		}
 	}
 
-	template<typename T>
-	typename HashMap<T>::Entry& HashMap<T>::get(uint64 key, const T& fallback_init, bool& o_fallback_used)
+	template<typename K, typename V, typename H>
+	typename HashMap<K, V, H>::Entry& HashMap<K, V, H>::get(const K& key, const V& fallback_init, bool& o_fallback_used)
 	{
-		auto fr = find(key);
+		uint64 hash = H::hash(key);
+		auto fr = find(key, hash);
 		if (present(fr))
 		{
 			o_fallback_used = false;
@@ -366,17 +513,14 @@ namespace arc
 		else
 		{
 			o_fallback_used = true;
-			if (m_hashes.size() == 0)
-			{
-				rehash(8);
-				fr.h_idx = key % m_hashes.size();
-			}
+			if (m_hashes.size() == 0) rehash(8);
 
-			Entry entry(key, fallback_init, m_hashes[fr.h_idx]);
+			auto& head = bucket(hash);
+			Entry entry(key, hash, fallback_init, head);
 			m_data.push_back(std::move(entry));
-			m_hashes[fr.h_idx] = m_data.size() - 1;
+			head = m_data.size() - 1;
 
-			if (load_factor() > 0.7f) rehash(m_hashes.size() * 2);
+			grow();
 			return m_data.back();
 		}
 	}
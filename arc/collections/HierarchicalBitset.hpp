@@ -0,0 +1,81 @@
+#pragma once
+
+#include "arc/core.hpp"
+#include "arc/collections/Array.hpp"
+#include "arc/collections/Slice.hpp"
+
+namespace arc
+{
+	/// Bitset with two summary levels on top of the bits. A level 1 bit tells whether a word
+	/// of 64 bits has any bit set, a level 2 bit the same for 4096 bits. Iteration walks down
+	/// from level 2 and only touches words with set bits, so sparse sets over many entities
+	/// are cheap to visit. Grows when bits beyond its size are set.
+	class HierarchicalBitset
+	{
+	public:
+		HierarchicalBitset() = default;
+		HierarchicalBitset(memory::Allocator& alloc, uint32 size = 0);
+	public:
+		HierarchicalBitset(HierarchicalBitset&& other);
+		HierarchicalBitset& operator=(HierarchicalBitset&& other);
+		ARC_NO_COPY(HierarchicalBitset);
+
+		using TriviallyRelocatable = std::true_type;
+
+	public:
+		void initialize(memory::Allocator* alloc, uint32 size = 0);
+		void finalize();
+		bool is_initialized();
+
+	public:
+		void set(uint32 idx);
+		void reset(uint32 idx);
+		bool test(uint32 idx) const;
+
+		void clear();
+		void reserve(uint32 size);
+
+	public:
+		uint32 size() const;		// number of bits, set or not
+		uint32 count() const;		// number of set bits
+		bool   empty() const;
+
+	public:
+		/// Keeps the bits that are also set in other.
+		void and_with(const HierarchicalBitset& other);
+		/// Adds the bits set in other.
+		void or_with(const HierarchicalBitset& other);
+
+	public:
+		/// Calls function(uint32 idx) for every set bit, in ascending order.
+		template<typename F>
+		void for_each(F function) const;
+
+		/// Calls function(uint32 idx) for every bit set in all / any of the bitsets, without
+		/// building the combined set. Ranges empty in the summaries are skipped.
+		template<typename F>
+		static void for_each_and(Slice<const HierarchicalBitset*> sets, F function);
+		template<typename F>
+		static void for_each_or(Slice<const HierarchicalBitset*> sets, F function);
+
+	private:
+		uint64 word(uint32 level, uint32 idx) const;
+		void   update_summaries(uint32 word_idx);
+
+		/// Calls function(uint32 word_idx) for every non-zero word of the bits.
+		template<typename F>
+		void for_each_word(F function) const;
+
+		template<bool AND, typename F>
+		static void for_each_combined(Slice<const HierarchicalBitset*> sets, F function);
+
+	private:
+		static const uint32 LEVELS = 3;
+		static const uint32 WORD_SHIFT = 6;
+		static const uint32 WORD_MASK = 63;
+
+		Array<uint64> m_levels[LEVELS];		// 0: bits, 1: non-empty words of 0, 2: non-empty words of 1
+		uint32 m_size = 0;
+	};
+
+} // namespace arc
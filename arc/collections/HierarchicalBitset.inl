@@ -0,0 +1,250 @@
+#pragma once
+
+#include "HierarchicalBitset.hpp"
+
+#include "arc/core.hpp"
+#include "arc/core/bits.hpp"
+#include "arc/collections/Array.inl"
+
+namespace arc
+{
+	inline HierarchicalBitset::HierarchicalBitset(memory::Allocator& alloc, uint32 size)
+	{
+		initialize(&alloc, size);
+	}
+
+	inline HierarchicalBitset::HierarchicalBitset(HierarchicalBitset&& other)
+		: m_size(other.m_size)
+	{
+		for (uint32 l = 0; l < LEVELS; l++) m_levels[l] = std::move(other.m_levels[l]);
+		other.m_size = 0;
+	}
+
+	inline HierarchicalBitset& HierarchicalBitset::operator=(HierarchicalBitset&& other)
+	{
+		if (this == &other) return *this;
+		finalize();
+
+		for (uint32 l = 0; l < LEVELS; l++) m_levels[l] = std::move(other.m_levels[l]);
+		m_size = other.m_size;
+		other.m_size = 0;
+		return *this;
+	}
+
+	inline void HierarchicalBitset::initialize(memory::Allocator* alloc, uint32 size)
+	{
+		finalize();
+
+		for (auto& level : m_levels) level.initialize(alloc);
+		reserve(size);
+	}
+
+	inline void HierarchicalBitset::finalize()
+	{
+		for (auto& level : m_levels) level.finalize();
+		m_size = 0;
+	}
+
+	inline bool HierarchicalBitset::is_initialized()
+	{
+		return m_levels[0].is_initialized();
+	}
+
+	inline void HierarchicalBitset::reserve(uint32 size)
+	{
+		if (size <= m_size) return;
+
+		// every level has one bit per word of the level below
+		uint32 words = (size + WORD_MASK) >> WORD_SHIFT;
+		m_size = words << WORD_SHIFT;
+		for (auto& level : m_levels)
+		{
+			level.resize(words, 0);
+			words = (words + WORD_MASK) >> WORD_SHIFT;
+		}
+	}
+
+	inline void HierarchicalBitset::set(uint32 idx)
+	{
+		if (idx >= m_size) reserve(idx + 1 > m_size * 2 ? idx + 1 : m_size * 2);
+
+		// the summary bits can be set unconditionally
+		for (auto& level : m_levels)
+		{
+			level[idx >> WORD_SHIFT] |= uint64(1) << (idx & WORD_MASK);
+			idx >>= WORD_SHIFT;
+		}
+	}
+
+	inline void HierarchicalBitset::reset(uint32 idx)
+	{
+		if (idx >= m_size) return;
+
+		m_levels[0][idx >> WORD_SHIFT] &= ~(uint64(1) << (idx & WORD_MASK));
+		update_summaries(idx >> WORD_SHIFT);
+	}
+
+	inline bool HierarchicalBitset::test(uint32 idx) const
+	{
+		return (word(0, idx >> WORD_SHIFT) >> (idx & WORD_MASK)) & 1;
+	}
+
+	inline void HierarchicalBitset::clear()
+	{
+		// only the words with set bits need to be cleared
+		auto& l0 = m_levels[0];
+		for_each_word([&](uint32 w) { l0[w] = 0; });
+		for (uint32 l = 1; l < LEVELS; l++)
+		{
+			for (auto& w : m_levels[l]) w = 0;
+		}
+	}
+
+	inline uint32 HierarchicalBitset::size() const
+	{
+		return m_size;
+	}
+
+	inline uint32 HierarchicalBitset::count() const
+	{
+		uint32 n = 0;
+		auto& l0 = m_levels[0];
+		for_each_word([&](uint32 w) { n += bits::popcount(l0[w]); });
+		return n;
+	}
+
+	inline bool HierarchicalBitset::empty() const
+	{
+		for (auto w : m_levels[LEVELS - 1]) if (w != 0) return false;
+		return true;
+	}
+
+	inline void HierarchicalBitset::and_with(const HierarchicalBitset& other)
+	{
+		auto& l0 = m_levels[0];
+		for_each_word([&](uint32 w)
+		{
+			l0[w] &= other.word(0, w);
+			if (l0[w] == 0) update_summaries(w);
+		});
+	}
+
+	inline void HierarchicalBitset::or_with(const HierarchicalBitset& other)
+	{
+		reserve(other.m_size);
+
+		auto& l0 = m_levels[0];
+		auto& other_bits = other.m_levels[0];
+		other.for_each_word([&](uint32 w)
+		{
+			l0[w] |= other_bits[w];
+			for (uint32 l = 1; l < LEVELS; l++)
+			{
+				m_levels[l][w >> WORD_SHIFT] |= uint64(1) << (w & WORD_MASK);
+				w >>= WORD_SHIFT;
+			}
+		});
+	}
+
+	inline uint64 HierarchicalBitset::word(uint32 level, uint32 idx) const
+	{
+		return idx < m_levels[level].size() ? m_levels[level][idx] : 0;
+	}
+
+	inline void HierarchicalBitset::update_summaries(uint32 word_idx)
+	{
+		// clears summary bits upwards as long as the words below became empty
+		for (uint32 l = 1; l < LEVELS; l++)
+		{
+			if (m_levels[l - 1][word_idx] != 0) return;
+			m_levels[l][word_idx >> WORD_SHIFT] &= ~(uint64(1) << (word_idx & WORD_MASK));
+			word_idx >>= WORD_SHIFT;
+		}
+	}
+
+	template<typename F> inline
+	void HierarchicalBitset::for_each_word(F function) const
+	{
+		auto& l2 = m_levels[2];
+		auto& l1 = m_levels[1];
+		for (uint32 i2 = 0; i2 < l2.size(); i2++)
+		{
+			for (uint64 m2 = l2[i2]; m2 != 0; m2 &= m2 - 1)
+			{
+				uint32 i1 = (i2 << WORD_SHIFT) | bits::trailing_zeros(m2);
+				for (uint64 m1 = l1[i1]; m1 != 0; m1 &= m1 - 1)
+				{
+					function((i1 << WORD_SHIFT) | bits::trailing_zeros(m1));
+				}
+			}
+		}
+	}
+
+	template<typename F> inline
+	void HierarchicalBitset::for_each(F function) const
+	{
+		auto& l0 = m_levels[0];
+		for_each_word([&](uint32 i0)
+		{
+			for (uint64 m0 = l0[i0]; m0 != 0; m0 &= m0 - 1)
+			{
+				function((i0 << WORD_SHIFT) | bits::trailing_zeros(m0));
+			}
+		});
+	}
+
+	template<typename F> inline
+	void HierarchicalBitset::for_each_and(Slice<const HierarchicalBitset*> sets, F function)
+	{
+		for_each_combined<true>(sets, function);
+	}
+
+	template<typename F> inline
+	void HierarchicalBitset::for_each_or(Slice<const HierarchicalBitset*> sets, F function)
+	{
+		for_each_combined<false>(sets, function);
+	}
+
+	template<bool AND, typename F> inline
+	void HierarchicalBitset::for_each_combined(Slice<const HierarchicalBitset*> sets, F function)
+	{
+		if (sets.size() == 0) return;
+
+		// missing words count as zero, so the summaries of an intersection may over-report
+		// but never miss a word, the bit level sorts it out
+		auto combine = [&](uint32 level, uint32 idx)
+		{
+			uint64 w = sets[0]->word(level, idx);
+			for (uint64 s = 1; s < sets.size(); s++)
+			{
+				if (AND) w &= sets[s]->word(level, idx);
+				else     w |= sets[s]->word(level, idx);
+			}
+			return w;
+		};
+
+		uint32 top_size = 0;
+		for (auto set : sets)
+		{
+			uint32 n = set->m_levels[2].size();
+			if (n > top_size) top_size = n;
+		}
+
+		for (uint32 i2 = 0; i2 < top_size; i2++)
+		{
+			for (uint64 m2 = combine(2, i2); m2 != 0; m2 &= m2 - 1)
+			{
+				uint32 i1 = (i2 << WORD_SHIFT) | bits::trailing_zeros(m2);
+				for (uint64 m1 = combine(1, i1); m1 != 0; m1 &= m1 - 1)
+				{
+					uint32 i0 = (i1 << WORD_SHIFT) | bits::trailing_zeros(m1);
+					for (uint64 m0 = combine(0, i0); m0 != 0; m0 &= m0 - 1)
+					{
+						function((i0 << WORD_SHIFT) | bits::trailing_zeros(m0));
+					}
+				}
+			}
+		}
+	}
+
+} // namespace arc
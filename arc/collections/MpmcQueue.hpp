@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+#include "arc/core.hpp"
+#include "arc/memory/Allocator.hpp"
+#include "arc/memory/util.hpp"
+
+namespace arc
+{
+	/* Bounded lock-free queue for any number of producer and consumer threads.
+	 * based on: Dmitry Vyukov's bounded MPMC queue
+	 *
+	 * Every slot carries a sequence number telling which ring position may use it next: a
+	 * producer claims position p when the slot's sequence is p, a consumer when it is p + 1.
+	 * Positions are claimed with a CAS on the shared counter, the slot itself is handed over
+	 * with the release store of its sequence. Bulk operations claim consecutive positions with
+	 * one CAS and may transfer fewer elements than asked for. */
+	template<typename T>
+	class MpmcQueue
+	{
+	public:
+		MpmcQueue(memory::Allocator* alloc, uint32 capacity);
+		MpmcQueue();
+		~MpmcQueue();
+	public:
+		ARC_NO_COPY(MpmcQueue);
+	public:
+		void initialize(memory::Allocator* alloc, uint32 capacity);
+		void finalize();
+		bool is_initialized();
+	public:
+		bool try_push(const T& value);
+		bool try_push(T&& value);
+		uint32 try_push_n(const T* values, uint32 n);
+	public:
+		bool try_pop(T& o_value);
+		uint32 try_pop_n(T* o_values, uint32 n);
+	public:
+		uint32 size() const;		// approximate while other threads are running
+		uint32 capacity() const;
+		bool empty() const;
+	private:
+		struct Cell
+		{
+			std::atomic<uint32> sequence;
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type value;
+
+			T* data() { return reinterpret_cast<T*>(&value); }
+		};
+	private:
+		template<typename F>
+		uint32 claim(std::atomic<uint32>& position, uint32 n, uint32 ready_offset, F on_cell);
+	private:
+		static const uint32 LINE = memory::util::CACHE_LINE_SIZE;
+
+		Cell*  m_cells = nullptr;
+		uint32 m_mask = 0;
+		memory::Allocator* m_alloc = nullptr;
+
+		char m_pad0[LINE];
+		std::atomic<uint32> m_enqueue_pos;
+		char m_pad1[LINE - sizeof(std::atomic<uint32>)];
+		std::atomic<uint32> m_dequeue_pos;
+		char m_pad2[LINE - sizeof(std::atomic<uint32>)];
+	};
+
+} // namespace arc
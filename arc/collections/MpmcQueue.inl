@@ -0,0 +1,182 @@
+#pragma once
+
+#include "MpmcQueue.hpp"
+
+#include "arc/core.hpp"
+#include "arc/memory/Allocator.hpp"
+#include "arc/memory/util.hpp"
+
+namespace arc
+{
+	template<typename T>
+	MpmcQueue<T>::MpmcQueue()
+		: m_enqueue_pos(0), m_dequeue_pos(0)
+	{}
+
+	template<typename T>
+	MpmcQueue<T>::MpmcQueue(memory::Allocator* alloc, uint32 capacity)
+		: m_enqueue_pos(0), m_dequeue_pos(0)
+	{
+		initialize(alloc, capacity);
+	}
+
+	template<typename T>
+	MpmcQueue<T>::~MpmcQueue()
+	{
+		finalize();
+	}
+
+	template<typename T>
+	void MpmcQueue<T>::initialize(memory::Allocator* alloc, uint32 capacity)
+	{
+		finalize();
+
+		// round up to a power of two, at least two slots so push and pop sequences differ
+		uint32 size = 2;
+		while (size < capacity) size *= 2;
+
+		m_alloc = alloc;
+		m_mask = size - 1;
+		m_cells = (Cell*)m_alloc->allocate(size*sizeof(Cell), alignof(Cell));
+		for (uint32 i = 0; i < size; i++) new (&m_cells[i].sequence) std::atomic<uint32>(i);
+
+		m_enqueue_pos.store(0, std::memory_order_relaxed);
+		m_dequeue_pos.store(0, std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	void MpmcQueue<T>::finalize()
+	{
+		if (is_initialized())
+		{
+			// destroy what was never popped, no other thread may use the queue anymore
+			uint32 pos = m_dequeue_pos.load(std::memory_order_relaxed);
+			uint32 end = m_enqueue_pos.load(std::memory_order_relaxed);
+			for (; pos != end; pos++) memory::util::delete_elements<T>(m_cells[pos & m_mask].data(), 1);
+
+			m_alloc->free(m_cells);
+			m_cells = nullptr;
+			m_mask = 0;
+			m_alloc = nullptr;
+		}
+	}
+
+	template<typename T>
+	bool MpmcQueue<T>::is_initialized()
+	{
+		return m_alloc != nullptr;
+	}
+
+	template<typename T>
+	template<typename F>
+	uint32 MpmcQueue<T>::claim(std::atomic<uint32>& position, uint32 n, uint32 ready_offset, F on_cell)
+	{
+		uint32 pos = position.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			// count the consecutive cells that are ready for the positions pos, pos + 1, ...
+			uint32 count = 0;
+			int32 diff = 0;
+			for (; count < n; count++)
+			{
+				uint32 seq = m_cells[(pos + count) & m_mask].sequence.load(std::memory_order_acquire);
+				diff = (int32)(seq - (pos + count + ready_offset));
+				if (diff != 0) break;
+			}
+
+			if (count > 0)
+			{
+				// the cells stay ready until their positions are claimed, which only happens here
+				if (position.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+				{
+					for (uint32 i = 0; i < count; i++) on_cell(m_cells[(pos + i) & m_mask], pos + i, i);
+					return count;
+				}
+				// pos was reloaded by the failed exchange
+			}
+			else if (diff < 0)
+			{
+				// the cell at pos still holds the previous round: full for producers, empty for consumers
+				return 0;
+			}
+			else
+			{
+				// another thread claimed pos in the meantime
+				pos = position.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template<typename T>
+	bool MpmcQueue<T>::try_push(const T& value)
+	{
+		return claim(m_enqueue_pos, 1, 0, [&](Cell& cell, uint32 pos, uint32)
+		{
+			new (cell.data()) T(value);
+			cell.sequence.store(pos + 1, std::memory_order_release);
+		}) == 1;
+	}
+
+	template<typename T>
+	bool MpmcQueue<T>::try_push(T&& value)
+	{
+		return claim(m_enqueue_pos, 1, 0, [&](Cell& cell, uint32 pos, uint32)
+		{
+			new (cell.data()) T(std::move(value));
+			cell.sequence.store(pos + 1, std::memory_order_release);
+		}) == 1;
+	}
+
+	template<typename T>
+	uint32 MpmcQueue<T>::try_push_n(const T* values, uint32 n)
+	{
+		return claim(m_enqueue_pos, n, 0, [&](Cell& cell, uint32 pos, uint32 i)
+		{
+			new (cell.data()) T(values[i]);
+			cell.sequence.store(pos + 1, std::memory_order_release);
+		});
+	}
+
+	template<typename T>
+	bool MpmcQueue<T>::try_pop(T& o_value)
+	{
+		return claim(m_dequeue_pos, 1, 1, [&](Cell& cell, uint32 pos, uint32)
+		{
+			o_value = std::move(*cell.data());
+			memory::util::delete_elements<T>(cell.data(), 1);
+			// the cell is free for the producer of the next round
+			cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+		}) == 1;
+	}
+
+	template<typename T>
+	uint32 MpmcQueue<T>::try_pop_n(T* o_values, uint32 n)
+	{
+		return claim(m_dequeue_pos, n, 1, [&](Cell& cell, uint32 pos, uint32 i)
+		{
+			o_values[i] = std::move(*cell.data());
+			memory::util::delete_elements<T>(cell.data(), 1);
+			cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+		});
+	}
+
+	template<typename T>
+	uint32 MpmcQueue<T>::size() const
+	{
+		int32 size = (int32)(m_enqueue_pos.load(std::memory_order_relaxed) - m_dequeue_pos.load(std::memory_order_relaxed));
+		return size < 0 ? 0 : (uint32)size;
+	}
+
+	template<typename T>
+	uint32 MpmcQueue<T>::capacity() const
+	{
+		return m_mask + 1;
+	}
+
+	template<typename T>
+	bool MpmcQueue<T>::empty() const
+	{
+		return size() == 0;
+	}
+
+} // namespace arc
@@ -13,6 +13,7 @@ namespace arc
 		Queue() = default;
 	public:
 		inline ~Queue() { finalize(); }
+		using TriviallyRelocatable = std::true_type;
 	public:
 		void initialize(memory::Allocator* alloc, uint32 capacity = 8);
 		void finalize();
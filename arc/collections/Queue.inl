@@ -53,8 +53,8 @@ namespace arc
 		ARC_ASSERT(size() > 0, "Called pop_back() on empty queue.");
 
 		T tmp;
-		memory::util::move_elements<T>(&front(), &tmp, 1);
-		collection_util::delete_elements<T>(&back(),1);
+		memory::util::move_elements<T>(&back(), &tmp, 1);
+		memory::util::delete_elements<T>(&back(),1);
 		m_size -= 1;
 		return tmp;
 	}
@@ -74,7 +74,7 @@ namespace arc
 	{
 		ARC_ASSERT(size() > 0, "Called remove_back() on empty queue.");
 
-		collection_util::delete_elements<T>(&back(), 1);
+		memory::util::delete_elements<T>(&back(), 1);
 		m_size -= 1;
 	}
 
@@ -99,16 +99,22 @@ namespace arc
 		namespace cu = arc::memory::util;
 
 		uint32 newm_capacity = m_capacity + additionalm_capacity;
-		T* newm_data = (T*)m_alloc->allocate(newm_capacity*sizeof(T),alignof(T));
 
 		uint32 frontm_size = std::min(m_size,m_capacity - m_first);
 		uint32 backm_size = m_size - frontm_size;
 
-		cu::move_construct_elements<T>(m_data+m_first,newm_data,frontm_size);
-		cu::delete_elements<T>(m_data+m_first,frontm_size);
+		// elements do not wrap around, grow without moving if the allocator can
+		if (backm_size == 0 && m_data != nullptr &&
+			m_alloc->try_expand_in_place(m_data, m_capacity*sizeof(T), newm_capacity*sizeof(T)))
+		{
+			m_capacity = newm_capacity;
+			return;
+		}
+
+		T* newm_data = (T*)m_alloc->allocate(newm_capacity*sizeof(T),alignof(T));
 
-		cu::move_construct_elements<T>(m_data,newm_data+frontm_size,backm_size);
-		cu::delete_elements<T>(m_data,backm_size);
+		cu::relocate_elements<T>(m_data+m_first,newm_data,frontm_size);
+		cu::relocate_elements<T>(m_data,newm_data+frontm_size,backm_size);
 
 		m_alloc->free(m_data);
 
@@ -144,11 +150,11 @@ namespace arc
 	Queue<T>::Queue(memory::Allocator* alloc, uint32 capacity)
 		: m_alloc(alloc), m_capacity(capacity)
 	{
-		m_data = (T*)alloc.allocate(capacity*sizeof(T),alignof(T));
+		m_data = (T*)alloc->allocate(capacity*sizeof(T),alignof(T));
 	}
 
 	template<typename T>
-	void Queue<T>::initialize(memory::Allocator* alloc, uint32 capacity = 8)
+	void Queue<T>::initialize(memory::Allocator* alloc, uint32 capacity)
 	{
 		finalize();
 
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <type_traits>
+
+#include "arc/core.hpp"
+#include "arc/collections/Slice.hpp"
+#include "arc/memory/Allocator.hpp"
+
+namespace arc
+{
+	/* Array with the same interface as Array<T> that keeps up to N elements in place and only
+	 * takes memory from its allocator beyond that. Meant for the many lists that hold a
+	 * handful of elements, those neither allocate nor add an indirection.
+	 * Not trivially relocatable, m_data points into the object while the elements are inline. */
+	template<typename T, uint32 N>
+	class SmallArray
+	{
+	public:
+		SmallArray(memory::Allocator& a, uint32 size = 0);
+		SmallArray() = default;
+		~SmallArray();
+	public: // move constructor and assignment
+		SmallArray(SmallArray<T, N>&& other);
+		SmallArray<T, N>& operator=(SmallArray<T, N>&& other);
+	public:
+		ARC_NO_COPY(SmallArray);
+	public:
+		T& operator[] (uint32 idx);
+		const T& operator[] (uint32 idx) const;
+
+	public:
+		uint32 size() const;
+		uint32 capacity() const;
+		bool empty() const;
+		bool is_inline() const;
+
+	public:
+		T* data();
+		const T* data() const;
+
+	public:
+		void push_back(const T& value = T());
+		void push_back(T&& value);
+
+		void pop_back();
+		T& back();
+		const T& back() const;
+
+	public:
+		template<typename ...Args>
+		void emplace_back(Args&& ...args);
+
+	public:
+		void resize(uint32 size);
+		void resize(uint32 size, const T& init_value);
+
+		void reserve(uint32 size);
+		void trim();
+		void clear();
+
+	public:
+		void initialize(memory::Allocator* alloc, uint32 size = 0);
+		void finalize();
+		bool is_initialized();
+
+	protected:
+		void _grow(uint32 min_capacity = 0);
+		void _take(SmallArray<T, N>& other);
+		T*   _inline_data();
+
+	protected:
+		using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+		memory::Allocator* m_allocator = nullptr;
+		T*                 m_data = reinterpret_cast<T*>(m_inline);
+		uint32             m_size = 0;
+		uint32             m_capacity = N;
+		Storage            m_inline[N];
+	};
+
+	// slice functionality ///////////////////////////////////////////////////////////////
+
+	template<typename T, uint32 N> ARC_CONSTEXPR
+	inline Slice<T> make_slice(SmallArray<T, N>& a)
+	{
+		return make_slice(a.data(), a.size());
+	}
+
+	template<typename T, uint32 N> ARC_CONSTEXPR
+	inline const Slice<T> make_slice(const SmallArray<T, N>& a)
+	{
+		return make_slice(a.data(), a.size());
+	}
+
+}
@@ -0,0 +1,348 @@
+#pragma once
+
+#include "SmallArray.hpp"
+
+#include "arc/memory/Allocator.hpp"
+#include "arc/memory/util.hpp"
+
+namespace arc
+{
+	template<typename T, uint32 N> inline
+	SmallArray<T, N>::SmallArray(memory::Allocator& a, uint32 size)
+		: m_allocator(&a)
+	{
+		resize(size);
+	}
+
+	template<typename T, uint32 N> inline
+	SmallArray<T, N>::~SmallArray()
+	{
+		finalize();
+	}
+
+	template<typename T, uint32 N> inline
+	SmallArray<T, N>::SmallArray(SmallArray<T, N>&& other)
+		: m_allocator(other.m_allocator)
+	{
+		_take(other);
+	}
+
+	template<typename T, uint32 N> inline
+	SmallArray<T, N>& SmallArray<T, N>::operator=(SmallArray<T, N>&& other)
+	{
+		if (this == &other) return *this;
+
+		// drop the own elements and heap memory, the allocator comes with other
+		clear();
+		if (!is_inline()) m_allocator->free(m_data);
+		m_data = _inline_data();
+		m_capacity = N;
+
+		m_allocator = other.m_allocator;
+		_take(other);
+		return *this;
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::_take(SmallArray<T, N>& other)
+	{
+		if (other.is_inline())
+		{
+			// inline elements have to be moved one by one
+			m_data = _inline_data();
+			m_capacity = N;
+			memory::util::relocate_elements<T>(other.m_data, m_data, other.m_size);
+		}
+		else
+		{
+			m_data = other.m_data;
+			m_capacity = other.m_capacity;
+		}
+		m_size = other.m_size;
+
+		other.m_data = other._inline_data();
+		other.m_size = 0;
+		other.m_capacity = N;
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::initialize(memory::Allocator* alloc, uint32 size)
+	{
+		if (is_initialized())
+		{
+			clear();
+			if (!is_inline()) m_allocator->free(m_data);
+			m_data = _inline_data();
+			m_capacity = N;
+		}
+
+		m_allocator = alloc;
+		resize(size);
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::finalize()
+	{
+		clear();
+		if (!is_inline()) m_allocator->free(m_data);
+		m_data = _inline_data();
+		m_capacity = N;
+		m_allocator = nullptr;
+	}
+
+	template<typename T, uint32 N> inline
+	bool SmallArray<T, N>::is_initialized()
+	{
+		return m_allocator != nullptr;
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::resize(uint32 size)
+	{
+		if (size > m_capacity)
+		{
+			_grow(size);
+		}
+		if (size > m_size)
+		{
+			memory::util::init_elements<T>(&m_data[m_size], size - m_size);
+		}
+		else
+		{
+			memory::util::delete_elements<T>(&m_data[size], m_size - size);
+		}
+		m_size = size;
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::resize(uint32 size, const T& init)
+	{
+		if (size > m_capacity)
+		{
+			_grow(size);
+		}
+		if (size > m_size)
+		{
+			auto dataT = &m_data[m_size];
+			uint32 n = size - m_size;
+			for (uint32 i = 0; i<n; i++)
+			{
+				// in place constructor
+				new (&dataT[i]) T(init);
+			}
+		}
+		else
+		{
+			memory::util::delete_elements<T>(&m_data[size], m_size - size);
+		}
+		m_size = size;
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::reserve(uint32 size)
+	{
+		if (size > m_capacity)
+		{
+			_grow(size);
+		}
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::trim()
+	{
+		if (is_inline() || m_capacity == m_size) return;
+
+		// move back into the object if the elements fit
+		if (m_size <= N)
+		{
+			auto heap_data = m_data;
+			m_data = _inline_data();
+			memory::util::relocate_elements<T>(heap_data, m_data, m_size);
+			m_allocator->free(heap_data);
+			m_capacity = N;
+			return;
+		}
+
+		// give the tail back without moving
+		if (m_allocator->try_expand_in_place(m_data, m_capacity*sizeof(T), m_size*sizeof(T)))
+		{
+			m_capacity = m_size;
+			return;
+		}
+
+		auto newData = m_allocator->allocate(m_size*sizeof(T), alignof(T));
+		memory::util::relocate_elements<T>(m_data, newData, m_size);
+		m_allocator->free(m_data);
+		m_data = (T*)newData;
+		m_capacity = m_size;
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::clear()
+	{
+		memory::util::delete_elements<T>(m_data, m_size);
+		m_size = 0;
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::_grow(uint32 min_capacity)
+	{
+		ARC_ASSERT(m_allocator != nullptr, "SmallArray grows beyond its inline capacity without an allocator");
+
+		// growth factor of 1.5, rounded up
+		uint32 nextCapacity = m_capacity + (uint32)(0.5*(m_capacity + 1));
+		// respect requested minimum capacity
+		if (min_capacity > nextCapacity) nextCapacity = min_capacity;
+
+		void* newData = nullptr;
+		if (is_inline())
+		{
+			// first spill to the heap
+			newData = m_allocator->allocate(nextCapacity*sizeof(T), alignof(T));
+			memory::util::relocate_elements<T>(m_data, newData, m_size);
+		}
+		else if (m_allocator->try_expand_in_place(m_data, m_capacity*sizeof(T), nextCapacity*sizeof(T)))
+		{
+			// grow without moving if the allocator can
+			m_capacity = nextCapacity;
+			return;
+		}
+		else if (is_trivially_relocatable<T>::value)
+		{
+			// the allocator moves the memory, no per element work
+			newData = m_allocator->reallocate(m_data, m_capacity*sizeof(T), nextCapacity*sizeof(T), alignof(T));
+		}
+		else
+		{
+			newData = m_allocator->allocate(nextCapacity*sizeof(T), alignof(T));
+			memory::util::relocate_elements<T>(m_data, newData, m_size);
+			m_allocator->free(m_data);
+		}
+		// book keeping
+		m_data = (T*)newData;
+		m_capacity = nextCapacity;
+	}
+
+	template<typename T, uint32 N> inline
+	T* SmallArray<T, N>::_inline_data()
+	{
+		return reinterpret_cast<T*>(m_inline);
+	}
+
+	template<typename T, uint32 N> inline
+	uint32 SmallArray<T, N>::size() const
+	{
+		return m_size;
+	}
+
+	template<typename T, uint32 N> inline
+	uint32 SmallArray<T, N>::capacity() const
+	{
+		return m_capacity;
+	}
+
+	template<typename T, uint32 N> inline
+	bool SmallArray<T, N>::empty() const
+	{
+		return m_size == 0;
+	}
+
+	template<typename T, uint32 N> inline
+	bool SmallArray<T, N>::is_inline() const
+	{
+		return m_data == reinterpret_cast<const T*>(m_inline);
+	}
+
+	template<typename T, uint32 N> inline
+	T& SmallArray<T, N>::operator[](uint32 idx)
+	{
+		return m_data[idx];
+	}
+
+	template<typename T, uint32 N> inline
+	const T& SmallArray<T, N>::operator[](uint32 idx) const
+	{
+		return m_data[idx];
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::push_back(const T& value)
+	{
+		reserve(m_size + 1);
+		new (&m_data[m_size]) T(value);
+		m_size += 1;
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::push_back(T&& value)
+	{
+		reserve(m_size + 1);
+		new (&m_data[m_size]) T(std::move(value));
+		m_size += 1;
+	}
+
+	template<typename T, uint32 N> inline
+	void SmallArray<T, N>::pop_back()
+	{
+		ARC_ASSERT(size() > 0, "Called pop_back() on empty SmallArray");
+		memory::util::delete_elements<T>(&back(), 1);
+		m_size -= 1;
+	}
+
+	template<typename T, uint32 N> inline
+	T& SmallArray<T, N>::back()
+	{
+		return m_data[m_size - 1];
+	}
+
+	template<typename T, uint32 N> inline
+	const T& SmallArray<T, N>::back() const
+	{
+		return m_data[m_size - 1];
+	}
+
+	template<typename T, uint32 N> inline
+	T* SmallArray<T, N>::data()
+	{
+		return m_data;
+	}
+
+	template<typename T, uint32 N> inline
+	const T* SmallArray<T, N>::data() const
+	{
+		return m_data;
+	}
+
+	template<typename T, uint32 N>
+	template<typename ...Args> inline
+	void SmallArray<T, N>::emplace_back(Args&& ...args)
+	{
+		reserve(m_size + 1);
+		new (&m_data[m_size]) T(std::forward<Args>(args)...);
+		m_size += 1;
+	}
+
+	template<typename T, uint32 N>
+	T* begin(arc::SmallArray<T, N>& a)
+	{
+		return a.data();
+	}
+
+	template<typename T, uint32 N>
+	T* end(arc::SmallArray<T, N>& a)
+	{
+		return a.data() + a.size();
+	}
+
+	template<typename T, uint32 N>
+	const T* begin(const arc::SmallArray<T, N>& a)
+	{
+		return a.data();
+	}
+
+	template<typename T, uint32 N>
+	const T* end(const arc::SmallArray<T, N>& a)
+	{
+		return a.data() + a.size();
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "arc/core.hpp"
+#include "arc/collections/Array.hpp"
+#include "arc/collections/Slice.hpp"
+
+namespace arc
+{
+	/// Set of integer keys, e.g. entity indices, numbered densely in insertion order.
+	/// The sparse side is an array of pages indexed by the key, holding positions into the
+	/// dense key array. Pages are only allocated for key ranges in use. Lookups cost two
+	/// dependent loads, removing a key moves the last key into its dense position.
+	class SparseSet
+	{
+	public:
+		SparseSet() = default;
+		SparseSet(memory::Allocator& alloc);
+		~SparseSet();
+	public:
+		SparseSet(SparseSet&& other);
+		SparseSet& operator=(SparseSet&& other);
+		ARC_NO_COPY(SparseSet);
+
+		using TriviallyRelocatable = std::true_type;
+
+	public:
+		void initialize(memory::Allocator* alloc);
+		void finalize();
+		bool is_initialized();
+
+	public:
+		/// Dense position of key, INVALID_INDEX if the key is not present.
+		uint32 index_of(uint32 key) const;
+		bool contains(uint32 key) const;
+
+		/// Appends key at the end of the dense array and returns its position,
+		/// or the position it already has.
+		uint32 insert(uint32 key);
+
+		/// Returns the freed dense position, which now holds the former last key, or
+		/// INVALID_INDEX if the key was not present. Callers keeping data parallel to
+		/// keys() move their last element to the same position.
+		uint32 remove(uint32 key);
+
+	public:
+		void reserve(uint32 size);
+		void clear();
+
+	public:
+		uint32 size() const;
+		Slice<const uint32> keys() const;
+
+	public:
+		static const uint32 INVALID_INDEX = -1;
+		static const uint32 PAGE_SHIFT = 10;
+		static const uint32 PAGE_SIZE = 1 << PAGE_SHIFT;		// keys per sparse page
+
+	private:
+		uint32& sparse_entry(uint32 key);
+
+	private:
+		memory::Allocator* m_alloc = nullptr;
+		Array<uint32*> m_pages;		// nullptr for pages without any key
+		Array<uint32>  m_dense;
+	};
+
+} // namespace arc
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "SparseSet.hpp"
+
+#include "arc/core.hpp"
+#include "arc/collections/Array.inl"
+
+namespace arc
+{
+	inline SparseSet::SparseSet(memory::Allocator& alloc)
+		: m_alloc(&alloc), m_pages(alloc), m_dense(alloc)
+	{}
+
+	inline SparseSet::~SparseSet()
+	{
+		finalize();
+	}
+
+	inline SparseSet::SparseSet(SparseSet&& other)
+		: m_alloc(other.m_alloc), m_pages(std::move(other.m_pages)), m_dense(std::move(other.m_dense))
+	{
+		other.m_alloc = nullptr;
+	}
+
+	inline SparseSet& SparseSet::operator=(SparseSet&& other)
+	{
+		if (this == &other) return *this;
+		finalize();
+
+		m_alloc = other.m_alloc;
+		m_pages = std::move(other.m_pages);
+		m_dense = std::move(other.m_dense);
+		other.m_alloc = nullptr;
+		return *this;
+	}
+
+	inline void SparseSet::initialize(memory::Allocator* alloc)
+	{
+		finalize();
+
+		m_alloc = alloc;
+		m_pages.initialize(alloc);
+		m_dense.initialize(alloc);
+	}
+
+	inline void SparseSet::finalize()
+	{
+		if (!is_initialized()) return;
+
+		for (auto page : m_pages) m_alloc->free(page);
+		m_pages.finalize();
+		m_dense.finalize();
+		m_alloc = nullptr;
+	}
+
+	inline bool SparseSet::is_initialized()
+	{
+		return m_alloc != nullptr;
+	}
+
+	inline uint32 SparseSet::index_of(uint32 key) const
+	{
+		uint32 page = key >> PAGE_SHIFT;
+		if (page >= m_pages.size() || m_pages[page] == nullptr) return INVALID_INDEX;
+		return m_pages[page][key & (PAGE_SIZE - 1)];
+	}
+
+	inline bool SparseSet::contains(uint32 key) const
+	{
+		return index_of(key) != INVALID_INDEX;
+	}
+
+	inline uint32& SparseSet::sparse_entry(uint32 key)
+	{
+		uint32 page = key >> PAGE_SHIFT;
+		if (page >= m_pages.size()) m_pages.resize(page + 1, nullptr);
+
+		auto& data = m_pages[page];
+		if (data == nullptr)
+		{
+			// all entries of a fresh page are unused
+			data = (uint32*)m_alloc->allocate(PAGE_SIZE * sizeof(uint32), alignof(uint32));
+			std::memset(data, 0xFF, PAGE_SIZE * sizeof(uint32));
+		}
+		return data[key & (PAGE_SIZE - 1)];
+	}
+
+	inline uint32 SparseSet::insert(uint32 key)
+	{
+		auto& entry = sparse_entry(key);
+		if (entry != INVALID_INDEX) return entry;
+
+		entry = m_dense.size();
+		m_dense.push_back(key);
+		return entry;
+	}
+
+	inline uint32 SparseSet::remove(uint32 key)
+	{
+		uint32 index = index_of(key);
+		if (index == INVALID_INDEX) return INVALID_INDEX;
+
+		// the last key takes over the freed position
+		uint32 last = m_dense.back();
+		m_dense[index] = last;
+		sparse_entry(last) = index;
+		sparse_entry(key) = INVALID_INDEX;
+		m_dense.pop_back();
+		return index;
+	}
+
+	inline void SparseSet::reserve(uint32 size)
+	{
+		m_dense.reserve(size);
+	}
+
+	inline void SparseSet::clear()
+	{
+		// only touch the pages that hold keys
+		for (auto key : m_dense) sparse_entry(key) = INVALID_INDEX;
+		m_dense.clear();
+	}
+
+	inline uint32 SparseSet::size() const
+	{
+		return m_dense.size();
+	}
+
+	inline Slice<const uint32> SparseSet::keys() const
+	{
+		return Slice<const uint32>(m_dense.data(), m_dense.size());
+	}
+
+} // namespace arc
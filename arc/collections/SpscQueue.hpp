@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+
+#include "arc/core.hpp"
+#include "arc/memory/Allocator.hpp"
+#include "arc/memory/util.hpp"
+
+namespace arc
+{
+	/* Lock-free ring buffer for exactly one producer and one consumer thread.
+	 *
+	 * The capacity is a power of two fixed at initialization, push fails when the queue is full.
+	 * Head and tail are free running counters, each written by one side only and published
+	 * with release stores. Both sides cache the other's counter and only reload it when the
+	 * queue looks full or empty, the counters live on separate cache lines. */
+	template<typename T>
+	class SpscQueue
+	{
+	public:
+		SpscQueue(memory::Allocator* alloc, uint32 capacity);
+		SpscQueue();
+		~SpscQueue();
+	public:
+		ARC_NO_COPY(SpscQueue);
+	public:
+		void initialize(memory::Allocator* alloc, uint32 capacity);
+		void finalize();
+		bool is_initialized();
+	public: // producer
+		bool push(const T& value);
+		bool push(T&& value);
+		uint32 push_n(const T* values, uint32 n);
+	public: // consumer
+		bool pop(T& o_value);
+		uint32 pop_n(T* o_values, uint32 n);
+	public:
+		uint32 size() const;		// exact only if neither side is running concurrently
+		uint32 capacity() const;
+		bool empty() const;
+	private:
+		uint32 free_slots(uint32 tail, uint32 wanted);
+		uint32 filled_slots(uint32 head, uint32 wanted);
+	private:
+		static const uint32 LINE = memory::util::CACHE_LINE_SIZE;
+
+		T*     m_data = nullptr;
+		uint32 m_mask = 0;
+		memory::Allocator* m_alloc = nullptr;
+
+		char m_pad0[LINE];
+		std::atomic<uint32> m_head;			// written by the consumer
+		uint32 m_cached_tail = 0;			// consumer's view of m_tail
+
+		char m_pad1[LINE - sizeof(std::atomic<uint32>) - sizeof(uint32)];
+		std::atomic<uint32> m_tail;			// written by the producer
+		uint32 m_cached_head = 0;			// producer's view of m_head
+
+		char m_pad2[LINE - sizeof(std::atomic<uint32>) - sizeof(uint32)];
+	};
+
+} // namespace arc
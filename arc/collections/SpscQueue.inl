@@ -0,0 +1,177 @@
+#pragma once
+
+#include "SpscQueue.hpp"
+
+#include "arc/core.hpp"
+#include "arc/memory/Allocator.hpp"
+#include "arc/memory/util.hpp"
+
+namespace arc
+{
+	template<typename T>
+	SpscQueue<T>::SpscQueue()
+		: m_head(0), m_tail(0)
+	{}
+
+	template<typename T>
+	SpscQueue<T>::SpscQueue(memory::Allocator* alloc, uint32 capacity)
+		: m_head(0), m_tail(0)
+	{
+		initialize(alloc, capacity);
+	}
+
+	template<typename T>
+	SpscQueue<T>::~SpscQueue()
+	{
+		finalize();
+	}
+
+	template<typename T>
+	void SpscQueue<T>::initialize(memory::Allocator* alloc, uint32 capacity)
+	{
+		finalize();
+
+		// round up to a power of two, ring indices are masked instead of taken modulo
+		uint32 size = 1;
+		while (size < capacity) size *= 2;
+
+		m_alloc = alloc;
+		m_mask = size - 1;
+		m_data = (T*)m_alloc->allocate(size*sizeof(T), alignof(T));
+		m_head.store(0, std::memory_order_relaxed);
+		m_tail.store(0, std::memory_order_relaxed);
+		m_cached_head = 0;
+		m_cached_tail = 0;
+	}
+
+	template<typename T>
+	void SpscQueue<T>::finalize()
+	{
+		if (is_initialized())
+		{
+			// destroy what was never popped
+			uint32 head = m_head.load(std::memory_order_relaxed);
+			uint32 tail = m_tail.load(std::memory_order_relaxed);
+			for (; head != tail; head++) memory::util::delete_elements<T>(&m_data[head & m_mask], 1);
+
+			m_alloc->free(m_data);
+			m_data = nullptr;
+			m_mask = 0;
+			m_alloc = nullptr;
+		}
+	}
+
+	template<typename T>
+	bool SpscQueue<T>::is_initialized()
+	{
+		return m_alloc != nullptr;
+	}
+
+	template<typename T>
+	uint32 SpscQueue<T>::free_slots(uint32 tail, uint32 wanted)
+	{
+		uint32 free = capacity() - (tail - m_cached_head);
+		if (free >= wanted) return free;
+
+		// the consumer may have moved on since we last looked
+		m_cached_head = m_head.load(std::memory_order_acquire);
+		return capacity() - (tail - m_cached_head);
+	}
+
+	template<typename T>
+	uint32 SpscQueue<T>::filled_slots(uint32 head, uint32 wanted)
+	{
+		uint32 filled = m_cached_tail - head;
+		if (filled >= wanted) return filled;
+
+		// the producer may have moved on since we last looked
+		m_cached_tail = m_tail.load(std::memory_order_acquire);
+		return m_cached_tail - head;
+	}
+
+	template<typename T>
+	bool SpscQueue<T>::push(const T& value)
+	{
+		uint32 tail = m_tail.load(std::memory_order_relaxed);
+		if (free_slots(tail, 1) == 0) return false;
+
+		new (&m_data[tail & m_mask]) T(value);
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	bool SpscQueue<T>::push(T&& value)
+	{
+		uint32 tail = m_tail.load(std::memory_order_relaxed);
+		if (free_slots(tail, 1) == 0) return false;
+
+		new (&m_data[tail & m_mask]) T(std::move(value));
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	uint32 SpscQueue<T>::push_n(const T* values, uint32 n)
+	{
+		uint32 tail = m_tail.load(std::memory_order_relaxed);
+		uint32 free = free_slots(tail, n);
+		if (n > free) n = free;
+
+		for (uint32 i = 0; i < n; i++) new (&m_data[(tail + i) & m_mask]) T(values[i]);
+
+		// a single release publishes the whole batch
+		m_tail.store(tail + n, std::memory_order_release);
+		return n;
+	}
+
+	template<typename T>
+	bool SpscQueue<T>::pop(T& o_value)
+	{
+		uint32 head = m_head.load(std::memory_order_relaxed);
+		if (filled_slots(head, 1) == 0) return false;
+
+		auto& slot = m_data[head & m_mask];
+		o_value = std::move(slot);
+		memory::util::delete_elements<T>(&slot, 1);
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	uint32 SpscQueue<T>::pop_n(T* o_values, uint32 n)
+	{
+		uint32 head = m_head.load(std::memory_order_relaxed);
+		uint32 filled = filled_slots(head, n);
+		if (n > filled) n = filled;
+
+		for (uint32 i = 0; i < n; i++)
+		{
+			auto& slot = m_data[(head + i) & m_mask];
+			o_values[i] = std::move(slot);
+			memory::util::delete_elements<T>(&slot, 1);
+		}
+
+		m_head.store(head + n, std::memory_order_release);
+		return n;
+	}
+
+	template<typename T>
+	uint32 SpscQueue<T>::size() const
+	{
+		return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+	}
+
+	template<typename T>
+	uint32 SpscQueue<T>::capacity() const
+	{
+		return m_mask + 1;
+	}
+
+	template<typename T>
+	bool SpscQueue<T>::empty() const
+	{
+		return size() == 0;
+	}
+
+} // namespace arc
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <initializer_list>
+
+#include "arc/core.hpp"
+#include "arc/collections/Slice.hpp"
+#include "arc/hash/Hasher.hpp"
+
+namespace arc
+{
+	namespace perfect_map
+	{
+		template<uint32 N, uint32 P = 1, bool DONE = (P >= N)>
+		struct NextPow2 { static const uint32 value = NextPow2<N, P * 2>::value; };
+
+		template<uint32 N, uint32 P>
+		struct NextPow2<N, P, true> { static const uint32 value = P; };
+	}
+
+	/* Collision free map over a fixed set of at most MAX_SIZE keys, e.g. StringHash32 names.
+	 * based on: hash and displace (Belazzougui, Botelho, Dietzfelbinger)
+	 *
+	 * The keys are split into buckets, every bucket gets a seed that moves all of its keys into
+	 * free slots. A lookup reads the seed of the key's bucket and compares the single slot it
+	 * points to, there are no probe sequences. Building searches the seeds and is meant to run
+	 * once, e.g. when a layout or shader is created or for a static table at startup, the keys
+	 * themselves can be hashed at compile time with SH32. Needs no allocations and can be copied. */
+	template<typename K, typename V, uint32 MAX_SIZE, typename H = Hasher<K>>
+	class StaticPerfectMap
+	{
+	public:
+		struct Entry
+		{
+			K key;
+			V value;
+		};
+	public:
+		StaticPerfectMap();
+		StaticPerfectMap(std::initializer_list<Entry> entries);
+
+	public:
+		/// Replaces the content, keys have to be unique. Returns false if no seeds were found.
+		bool build(Slice<const Entry> entries);
+		void clear();
+
+	public:
+		const V* lookup(const K& key) const;
+		bool contains(const K& key) const;
+		uint32 size() const;
+
+	private:
+		static uint32 slot(uint64 key_hash, uint32 seed);
+
+	private:
+		static const uint32 SLOTS = perfect_map::NextPow2<MAX_SIZE>::value;
+		static const uint32 BUCKETS = perfect_map::NextPow2<(MAX_SIZE + 1) / 2>::value;	// about two keys per bucket
+		static const uint32 MAX_SEED = 1 << 16;
+
+		uint32 m_seeds[BUCKETS];
+		K      m_keys[SLOTS];		// free slots repeat a key placed elsewhere, so they never match
+		V      m_values[SLOTS];
+		uint32 m_size = 0;
+	};
+
+} // namespace arc
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "StaticPerfectMap.hpp"
+
+#include <algorithm>
+
+#include "arc/core.hpp"
+#include "arc/hash/mix.hpp"
+
+namespace arc
+{
+	template<typename K, typename V, uint32 MAX_SIZE, typename H> inline
+	StaticPerfectMap<K, V, MAX_SIZE, H>::StaticPerfectMap()
+	{
+		clear();
+	}
+
+	template<typename K, typename V, uint32 MAX_SIZE, typename H> inline
+	StaticPerfectMap<K, V, MAX_SIZE, H>::StaticPerfectMap(std::initializer_list<Entry> entries)
+	{
+		build(Slice<const Entry>(entries.begin(), entries.size()));
+	}
+
+	template<typename K, typename V, uint32 MAX_SIZE, typename H> inline
+	bool StaticPerfectMap<K, V, MAX_SIZE, H>::build(Slice<const Entry> entries)
+	{
+		ARC_ASSERT(entries.size() <= MAX_SIZE, "Too many entries for StaticPerfectMap");
+		clear();
+		if (entries.size() == 0) return true;
+
+		uint32 count = (uint32)entries.size();
+		uint64 hashes[MAX_SIZE];
+		uint32 bucket_size[BUCKETS] = {};
+		for (uint32 i = 0; i < count; i++)
+		{
+			hashes[i] = H::hash(entries[i].key);
+			bucket_size[hashes[i] & (BUCKETS - 1)]++;
+		}
+
+		// large buckets are placed first, while most slots are still free
+		uint32 order[BUCKETS];
+		for (uint32 b = 0; b < BUCKETS; b++) order[b] = b;
+		std::sort(order, order + BUCKETS, [&](uint32 a, uint32 b) { return bucket_size[a] > bucket_size[b]; });
+
+		bool taken[SLOTS] = {};
+		for (uint32 b : order)
+		{
+			if (bucket_size[b] == 0) break;
+
+			uint32 members[MAX_SIZE];
+			uint32 member_count = 0;
+			for (uint32 i = 0; i < count; i++)
+			{
+				if ((hashes[i] & (BUCKETS - 1)) == b) members[member_count++] = i;
+			}
+
+			// try seeds until every key of the bucket lands in its own free slot
+			uint32 targets[MAX_SIZE];
+			uint32 seed = 1;
+			for (; seed < MAX_SEED; seed++)
+			{
+				uint32 m = 0;
+				for (; m < member_count; m++)
+				{
+					targets[m] = slot(hashes[members[m]], seed);
+					if (taken[targets[m]]) break;
+					taken[targets[m]] = true;
+				}
+				if (m == member_count) break;
+
+				// undo the partial placement
+				while (m-- > 0) taken[targets[m]] = false;
+			}
+			if (seed == MAX_SEED)
+			{
+				ARC_ASSERT(false, "StaticPerfectMap found no seed, are the keys unique?");
+				clear();
+				return false;
+			}
+
+			m_seeds[b] = seed;
+			for (uint32 m = 0; m < member_count; m++)
+			{
+				m_keys[targets[m]] = entries[members[m]].key;
+				m_values[targets[m]] = entries[members[m]].value;
+			}
+		}
+
+		for (uint32 s = 0; s < SLOTS; s++)
+		{
+			if (!taken[s]) m_keys[s] = entries[0].key;
+		}
+		m_size = count;
+		return true;
+	}
+
+	template<typename K, typename V, uint32 MAX_SIZE, typename H> inline
+	void StaticPerfectMap<K, V, MAX_SIZE, H>::clear()
+	{
+		for (auto& seed : m_seeds) seed = 0;
+		for (auto& key : m_keys) key = K();
+		for (auto& value : m_values) value = V();
+		m_size = 0;
+	}
+
+	template<typename K, typename V, uint32 MAX_SIZE, typename H> inline
+	const V* StaticPerfectMap<K, V, MAX_SIZE, H>::lookup(const K& key) const
+	{
+		uint64 hash = H::hash(key);
+		uint32 s = slot(hash, m_seeds[hash & (BUCKETS - 1)]);
+		return m_size != 0 && H::equal(m_keys[s], key) ? &m_values[s] : nullptr;
+	}
+
+	template<typename K, typename V, uint32 MAX_SIZE, typename H> inline
+	bool StaticPerfectMap<K, V, MAX_SIZE, H>::contains(const K& key) const
+	{
+		return lookup(key) != nullptr;
+	}
+
+	template<typename K, typename V, uint32 MAX_SIZE, typename H> inline
+	uint32 StaticPerfectMap<K, V, MAX_SIZE, H>::size() const
+	{
+		return m_size;
+	}
+
+	template<typename K, typename V, uint32 MAX_SIZE, typename H> inline
+	uint32 StaticPerfectMap<K, V, MAX_SIZE, H>::slot(uint64 key_hash, uint32 seed)
+	{
+		return (uint32)hash::mix64(key_hash ^ seed) & (SLOTS - 1);
+	}
+
+} // namespace arc
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "arc/core.hpp"
+#include "arc/collections/Slice.hpp"
+#include "arc/memory/VirtualArena.hpp"
+
+namespace arc
+{
+	/* Array with the same interface as Array<T> that reserves address space for max_size
+	 * elements up front and commits memory as it grows. Elements are never moved, so
+	 * pointers to them stay valid until they are removed. */
+	template<typename T>
+	class VirtualArray
+	{
+	public:
+		VirtualArray(uint32 max_size, uint32 size = 0);
+		VirtualArray() = default;
+		~VirtualArray();
+	public: // move constructor and assignment
+		VirtualArray(VirtualArray<T>&& other);
+		VirtualArray<T>& operator=(VirtualArray<T>&& other);
+	public:
+		ARC_NO_COPY(VirtualArray);
+		using TriviallyRelocatable = std::true_type;
+	public:
+		T& operator[] (uint32 idx);
+		const T& operator[] (uint32 idx) const;
+
+	public:
+		uint32 size() const;
+		uint32 capacity() const;
+		uint32 max_size() const;
+		bool empty() const;
+
+	public:
+		T* data();
+		const T* data() const;
+
+	public:
+		void push_back(const T& value = T());
+		void push_back(T&& value);
+
+		void pop_back();
+		T& back();
+		const T& back() const;
+
+	public:
+		template<typename ...Args>
+		void emplace_back(Args&& ...args);
+
+	public:
+		void resize(uint32 size);
+		void resize(uint32 size, const T& init_value);
+
+		void reserve(uint32 size);
+		void trim();
+		void clear();
+
+	public:
+		/// Returns false if the address space or the first size elements could not be obtained.
+		bool initialize(uint32 max_size, uint32 size = 0);
+		void finalize();
+		bool is_initialized();
+
+	protected:
+		void _grow(uint32 min_capacity);
+
+	protected:
+		memory::VirtualArena m_arena;
+		T*                   m_data = nullptr;
+		uint32               m_size = 0;
+		uint32               m_capacity = 0;
+		uint32               m_max_size = 0;
+	};
+
+	// slice functionality ///////////////////////////////////////////////////////////////
+
+	template<typename T> ARC_CONSTEXPR
+	inline Slice<T> make_slice(VirtualArray<T>& a)
+	{
+		return make_slice(a.data(), a.size());
+	}
+
+	template<typename T> ARC_CONSTEXPR
+	inline const Slice<T> make_slice(const VirtualArray<T>& a)
+	{
+		return make_slice(a.data(), a.size());
+	}
+
+}
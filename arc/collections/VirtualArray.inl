@@ -0,0 +1,286 @@
+#pragma once
+
+#include "VirtualArray.hpp"
+
+#include "arc/memory/util.hpp"
+
+namespace arc
+{
+	template<typename T> inline
+	VirtualArray<T>::VirtualArray(uint32 max_size, uint32 size)
+	{
+		initialize(max_size, size);
+	}
+
+	template<typename T> inline
+	VirtualArray<T>::~VirtualArray()
+	{
+		finalize();
+	}
+
+	template<typename T> inline
+	VirtualArray<T>::VirtualArray(VirtualArray<T>&& other)
+		: m_arena(std::move(other.m_arena))
+		, m_data(other.m_data)
+		, m_size(other.m_size)
+		, m_capacity(other.m_capacity)
+		, m_max_size(other.m_max_size)
+	{
+		other.m_data = nullptr;
+		other.m_size = 0;
+		other.m_capacity = 0;
+		other.m_max_size = 0;
+	}
+
+	template<typename T> inline
+	VirtualArray<T>& VirtualArray<T>::operator=(VirtualArray<T>&& other)
+	{
+		finalize();
+
+		m_arena = std::move(other.m_arena);
+		m_data = other.m_data;
+		m_size = other.m_size;
+		m_capacity = other.m_capacity;
+		m_max_size = other.m_max_size;
+
+		other.m_data = nullptr;
+		other.m_size = 0;
+		other.m_capacity = 0;
+		other.m_max_size = 0;
+
+		return *this;
+	}
+
+	template<typename T> inline
+	bool VirtualArray<T>::initialize(uint32 max_size, uint32 size)
+	{
+		finalize();
+
+		if (size > max_size) return false;
+		if (!m_arena.reserve((uint64)max_size * sizeof(T))) return false;
+		if (!m_arena.commit((uint64)size * sizeof(T)))
+		{
+			m_arena.release();
+			return false;
+		}
+
+		m_data = (T*)m_arena.data();
+		m_max_size = max_size;
+		resize(size);
+		return true;
+	}
+
+	template<typename T> inline
+	void VirtualArray<T>::finalize()
+	{
+		if (is_initialized())
+		{
+			clear();
+			m_arena.release();
+			m_data = nullptr;
+			m_capacity = m_max_size = 0;
+		}
+	}
+
+	template<typename T> inline
+	bool VirtualArray<T>::is_initialized()
+	{
+		return m_data != nullptr;
+	}
+
+	template<typename T> inline
+	void VirtualArray<T>::clear()
+	{
+		memory::util::delete_elements<T>(m_data, m_size);
+		m_size = 0;
+	}
+
+	template<typename T>
+	inline void VirtualArray<T>::resize(uint32 size)
+	{
+		if (size > m_capacity)
+		{
+			_grow(size);
+		}
+		if (size > m_size)
+		{
+			memory::util::init_elements<T>(&m_data[m_size], size - m_size);
+		}
+		else
+		{
+			memory::util::delete_elements<T>(&m_data[size], m_size - size);
+		}
+		m_size = size;
+	}
+
+	template<typename T>
+	inline void VirtualArray<T>::resize(uint32 size, const T& init)
+	{
+		if (size > m_capacity)
+		{
+			_grow(size);
+		}
+		if (size > m_size)
+		{
+			auto dataT = &m_data[m_size];
+			uint32 n = size - m_size;
+			for (uint32 i = 0; i<n; i++)
+			{
+				// in place constructor
+				new (&dataT[i]) T(init);
+			}
+		}
+		else
+		{
+			memory::util::delete_elements<T>(&m_data[size], m_size - size);
+		}
+		m_size = size;
+	}
+
+	template<typename T> inline
+	void VirtualArray<T>::reserve(uint32 size)
+	{
+		if (size > m_capacity)
+		{
+			_grow(size);
+		}
+	}
+
+	template<typename T> inline
+	void VirtualArray<T>::trim()
+	{
+		m_arena.decommit((uint64)m_size * sizeof(T));
+		m_capacity = (uint32)(m_arena.committed() / sizeof(T));
+	}
+
+	template<typename T> inline
+	void VirtualArray<T>::_grow(uint32 min_capacity)
+	{
+		// elements would be written past the reservation, there is no way to continue
+		ARC_ASSERT(min_capacity <= m_max_size, "VirtualArray: maximum size exceeded");
+		if (min_capacity > m_max_size) ARC_FAIL_GRACEFULLY_MESSAGE("VirtualArray: maximum size exceeded");
+
+		// commit more pages behind the elements, nothing is moved
+		bool ok = m_arena.commit((uint64)min_capacity * sizeof(T));
+		ARC_ASSERT(ok, "VirtualArray: could not commit memory");
+		if (!ok) ARC_FAIL_GRACEFULLY_MESSAGE("VirtualArray: could not commit memory");
+
+		uint64 capacity = m_arena.committed() / sizeof(T);
+		m_capacity = capacity > m_max_size ? m_max_size : (uint32)capacity;
+	}
+
+	template<typename T> inline
+	uint32 VirtualArray<T>::size() const
+	{
+		return m_size;
+	}
+
+	template<typename T> inline
+	uint32 VirtualArray<T>::capacity() const
+	{
+		return m_capacity;
+	}
+
+	template<typename T> inline
+	uint32 VirtualArray<T>::max_size() const
+	{
+		return m_max_size;
+	}
+
+	template<typename T> inline
+	bool VirtualArray<T>::empty() const
+	{
+		return m_size == 0;
+	}
+
+	template<typename T> inline
+	T& VirtualArray<T>::operator[](uint32 idx)
+	{
+		return m_data[idx];
+	}
+
+	template<typename T> inline
+	const T& VirtualArray<T>::operator[](uint32 idx) const
+	{
+		return m_data[idx];
+	}
+
+	template<typename T> inline
+	void VirtualArray<T>::push_back(const T& value)
+	{
+		resize(m_size + 1);
+		back() = value;
+	}
+
+	template<typename T> inline
+	void VirtualArray<T>::push_back(T&& value)
+	{
+		resize(m_size + 1);
+		back() = std::move(value);
+	}
+
+	template<typename T> inline
+	void VirtualArray<T>::pop_back()
+	{
+		ARC_ASSERT(size() > 0, "Called pop_back() on empty VirtualArray");
+		memory::util::delete_elements<T>(&back(), 1);
+		m_size -= 1;
+	}
+
+	template<typename T> inline
+	T& VirtualArray<T>::back()
+	{
+		return m_data[m_size - 1];
+	}
+
+	template<typename T> inline
+	const T& VirtualArray<T>::back() const
+	{
+		return m_data[m_size - 1];
+	}
+
+	template<typename T> inline
+	T* VirtualArray<T>::data()
+	{
+		return m_data;
+	}
+
+	template<typename T> inline
+	const T* VirtualArray<T>::data() const
+	{
+		return m_data;
+	}
+
+	template<typename T>
+	template<typename ...Args> inline
+	void VirtualArray<T>::emplace_back(Args&& ...args)
+	{
+		if (m_size + 1 > m_capacity) _grow(m_size + 1);
+		new (&m_data[m_size]) T(std::forward<Args>(args)...);
+		m_size += 1;
+	}
+
+	template<typename T>
+	T* begin(arc::VirtualArray<T>& a)
+	{
+		return a.data();
+	}
+
+	template<typename T>
+	T* end(arc::VirtualArray<T>& a)
+	{
+		return a.data() + a.size();
+	}
+
+	template<typename T>
+	const T* begin(const arc::VirtualArray<T>& a)
+	{
+		return a.data();
+	}
+
+	template<typename T>
+	const T* end(const arc::VirtualArray<T>& a)
+	{
+		return a.data() + a.size();
+	}
+}
@@ -49,6 +49,7 @@ namespace arc
 #include "arc/core/assert.hpp"
 //#include "arc/core/exception.hpp"
 #include "arc/core/numeric_types.hpp"
+#include "arc/core/type_traits.hpp"
 //#include "arc/core/smart_pointers.hpp"
 //#include "arc/core/slice.hpp"
 //#include "arc/logging/interface.hpp"
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "numeric_types.hpp"
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+namespace arc { namespace bits {
+
+	/* Index of the lowest set bit, v must not be zero. */
+	inline uint32 trailing_zeros(uint64 v)
+	{
+#if defined(_MSC_VER) && defined(_WIN64)
+		unsigned long idx;
+		_BitScanForward64(&idx, v);
+		return (uint32)idx;
+#elif defined(_MSC_VER)
+		unsigned long idx;
+		if (_BitScanForward(&idx, (uint32)v)) return (uint32)idx;
+		_BitScanForward(&idx, (uint32)(v >> 32));
+		return (uint32)idx + 32;
+#else
+		return (uint32)__builtin_ctzll(v);
+#endif
+	}
+
+	/* Number of set bits. */
+	inline uint32 popcount(uint64 v)
+	{
+#if defined(_MSC_VER) && defined(_WIN64)
+		return (uint32)__popcnt64(v);
+#elif defined(_MSC_VER)
+		return (uint32)(__popcnt((uint32)v) + __popcnt((uint32)(v >> 32)));
+#else
+		return (uint32)__builtin_popcountll(v);
+#endif
+	}
+
+}}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <type_traits>
+
+namespace arc
+{
+	namespace type_traits_implementation
+	{
+		template<typename T> struct void_type { using type = void; };
+	}
+
+	/* True if an object can be moved to another address with memcpy, without calling its
+	 * move constructor and destructor. Holds for trivial types. Other types opt in with a
+	 * member typedef
+	 *     using TriviallyRelocatable = std::true_type;
+	 * or by specializing is_trivially_relocatable. */
+	template<typename T, typename = void>
+	struct is_trivially_relocatable
+		: std::integral_constant<bool, std::is_trivial<T>::value>
+	{};
+
+	template<typename T>
+	struct is_trivially_relocatable<T, typename type_traits_implementation::void_type<typename T::TriviallyRelocatable>::type>
+		: std::integral_constant<bool, std::is_trivial<T>::value || T::TriviallyRelocatable::value>
+	{};
+
+} // namespace arc
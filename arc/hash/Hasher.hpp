@@ -0,0 +1,26 @@
+#pragma once
+
+#include "arc/core.hpp"
+
+namespace arc
+{
+	/* Hash functions for the keys of HashMap, specialized per key type K. A hasher provides
+	 *   static uint64 hash(const Q& key)              for K and every type Q keys are looked up with
+	 *   static bool   equal(const K& a, const Q& b)
+	 *   static const bool CACHE_HASH                  true stores the hash next to each key,
+	 *                                                 worth it when hashing or comparing is expensive
+	 * Keys that compare equal must hash equal, also across key types. */
+	template<typename K>
+	struct Hasher;
+
+	/* uint64 keys are expected to be hashed already and are used as they are. */
+	template<>
+	struct Hasher<uint64>
+	{
+		static const bool CACHE_HASH = false;
+
+		static uint64 hash(uint64 key) { return key; }
+		static bool equal(uint64 a, uint64 b) { return a == b; }
+	};
+
+} // namespace arc
@@ -1,7 +1,10 @@
 #pragma once
 
 
+#include <cstring>
+
 #include "arc/core.hpp"
+#include "arc/hash/Hasher.hpp"
 
 #include "arc/string/String.hpp"
 #include "arc/string/StringView.hpp"
@@ -61,7 +64,7 @@ namespace arc { namespace hash {
 		ARC_CONSTEXPR StringHash64() {}
 		ARC_CONSTEXPR StringHash64(uint64 value) : m_value(value) {}
 
-		uint64 value() { return m_value;  }
+		uint64 value() const { return m_value;  }
 	private:
 		uint64 m_value = 0;
 	};
@@ -136,6 +139,40 @@ namespace arc { namespace hash {
 		return{ hash::fnv_1a::rt64(s.c_str(), s.length()) };
 	}
 
+	// hashers for HashMap //////////////////////////////////////////////////
+
+	/* Precomputed string hashes are used as they are. */
+	template<>
+	struct Hasher<StringHash64>
+	{
+		static const bool CACHE_HASH = false;
+
+		static uint64 hash(StringHash64 key) { return key.value(); }
+		static bool equal(StringHash64 a, StringHash64 b) { return a == b; }
+	};
+
+	template<>
+	struct Hasher<StringHash32>
+	{
+		static const bool CACHE_HASH = false;
+
+		static uint64 hash(StringHash32 key) { return key.value(); }
+		static bool equal(StringHash32 a, StringHash32 b) { return a == b; }
+	};
+
+	/* String keys can be looked up with a StringView or a literal without building a String. */
+	template<>
+	struct Hasher<String>
+	{
+		static const bool CACHE_HASH = true;
+
+		static uint64 hash(StringView key) { return arc::hash::fnv_1a::rt64(key.c_str(), key.length()); }
+		static bool equal(StringView a, StringView b)
+		{
+			return a.length() == b.length() && std::memcmp(a.c_str(), b.c_str(), a.length()) == 0;
+		}
+	};
+
 } // namespace arc
 
 #define SH(ARG) string_hash(""ARG)
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "arc/core.hpp"
+
+namespace arc { namespace hash {
+
+	/* Scrambles all bits of an integer key, so that sequential ids spread over the whole range.
+	 * Finalizer of MurmurHash3. */
+	inline uint64 mix64(uint64 key)
+	{
+		key ^= key >> 33;
+		key *= 0xff51afd7ed558ccdULL;
+		key ^= key >> 33;
+		key *= 0xc4ceb9fe1a85ec53ULL;
+		key ^= key >> 33;
+		return key;
+	}
+
+}}
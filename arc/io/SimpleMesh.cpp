@@ -2,6 +2,7 @@
 
 #include "../renderer/RendererBase.hpp"
 #include "arc/logging/log.hpp"
+#include "arc/memory/scratch.hpp"
 
 namespace arc { namespace io {
 
@@ -16,15 +17,6 @@ namespace arc { namespace io {
 
 		MeshHeader header;
 		PartHeader ph;
-		uint32_t next_offset = 0;
-
-		renderer::VertexAttribute attributes[16];
-
-		attributes[0] = renderer::VertexAttribute(
-			SH32("position"),
-			renderer::VertexAttribute::Type::float32,
-			3, next_offset);
-		next_offset += 3*sizeof(float);
 
 		in.read(&header, sizeof(MeshHeader));
 		if (!valid(header)) { LOG_ERROR("Invalid SimpleMesh Header"); return false; }
@@ -36,7 +28,17 @@ namespace arc { namespace io {
 			if (!valid(ph)) { LOG_ERROR("Invalid SimpleMesh Part Header"); return false; }
 
 			uint32_t att_count = count_attributes(ph);
-			if (att_count > 16) { LOG_ERROR("Mesh has too many attributes."); return false; }
+
+			memory::ScratchScope scratch;
+			auto attributes = scratch.allocator().create_n<renderer::VertexAttribute>(att_count);
+			if (attributes == nullptr) { LOG_ERROR("Out of scratch memory for the SimpleMesh vertex layout"); return false; }
+			uint32_t next_offset = 0;
+
+			attributes[0] = renderer::VertexAttribute(
+				SH32("position"),
+				renderer::VertexAttribute::Type::float32,
+				3, next_offset);
+			next_offset += 3*sizeof(float);
 
 			uint32_t att_idx = 1;
 			if (ph.attributes.normal)
@@ -55,7 +57,7 @@ namespace arc { namespace io {
 					4, next_offset);
 				next_offset += 4 * sizeof(uint8_t);
 			}
-			if (ph.attributes.color1)
+			if (ph.attributes.color2)
 			{
 				attributes[att_idx++] = renderer::VertexAttribute(
 					SH32("color2"),
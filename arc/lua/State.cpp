@@ -3,6 +3,7 @@
 
 #include "arc/string/String.hpp"
 #include "arc/string/StringView.hpp"
+#include "arc/memory/Allocator.hpp"
 
 // lua_Integer 64bit
 // lua_Unsigned 32bit
@@ -139,11 +140,41 @@ namespace arc { namespace lua {
         // read string
         size_t len;
         const char* ptr = lua_tolstring(m_state,STACK_TOP,&len);
-        out_value = String(ptr,len);
+        out_value.assign(ptr,(uint32)len);
         lua_pop(m_state,1);
         return true;
     }
 
+    bool Value::get(StringView& out_value, memory::Allocator& alloc)
+    {
+        // safety check
+        if (!valid()) return false;
+
+        // get value from registry
+        lua_rawgeti(m_state, LUA_REGISTRYINDEX, m_ref);
+
+        // check type
+        auto type = lua_type(m_state,STACK_TOP);
+        if (type != LUA_TSTRING)
+        {
+            lua_pop(m_state,1);
+            return false;
+        }
+
+        // copy string, the lua string may be collected once the value is gone
+        size_t len;
+        const char* ptr = lua_tolstring(m_state,STACK_TOP,&len);
+        char* copy = (char*)alloc.allocate(len + 1, 1);
+        if (copy != nullptr)
+        {
+            memcpy(copy, ptr, len);
+            copy[len] = '\0';
+            out_value = StringView(copy, 0, (uint32)len);
+        }
+        lua_pop(m_state,1);
+        return copy != nullptr;
+    }
+
     bool Value::get(bool &out_value)
     {
         // safety check
@@ -51,6 +51,8 @@ namespace arc { namespace lua {
     public:
         bool get(int32 &out_value);
         bool get(String& out_value);
+        /* copies the string into alloc, the copy is null terminated */
+        bool get(StringView& out_value, memory::Allocator& alloc);
         bool get(bool& out_value);
     public:
         template<typename ...Args>
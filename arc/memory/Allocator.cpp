@@ -2,18 +2,42 @@
 
 #include "arc/core.hpp"
 #include "arc/core/numeric_types.hpp"
+#include "arc/memory/no_alloc.hpp"
 
 #include "arc/logging/log.hpp"
 
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 namespace arc { namespace memory {
 
 	DummyAllocator g_dummy_allocator;
 
+    bool Allocator::try_expand_in_place(void* data, uint64 old_size, uint64 new_size)
+    {
+        return false;
+    }
+
+    void* Allocator::reallocate(void* data, uint64 old_size, uint64 new_size, uint32 align)
+    {
+        if (data != nullptr && try_expand_in_place(data, old_size, new_size)) return data;
+
+        void* new_data = allocate(new_size, align);
+        if (new_data == nullptr) return nullptr;
+
+        if (data != nullptr)
+        {
+            std::memcpy(new_data, data, (size_t)(old_size < new_size ? old_size : new_size));
+            free(data);
+        }
+        return new_data;
+    }
+
     void* Mallocator::allocate(uint64 size, uint32 align)
     {
+        no_alloc::check(size);
+
         //TODO handle alignment
         auto ptr = std::malloc((size_t)size);
 		LOG_DEBUG(ptr, " = allocate(", size, ",", align, ")");
@@ -27,6 +51,16 @@ namespace arc { namespace memory {
         std::free(data);
     }
 
+    void* Mallocator::reallocate(void* data, uint64 old_size, uint64 new_size, uint32 align)
+    {
+        if (new_size > old_size) no_alloc::check(new_size);
+
+        //TODO handle alignment
+        auto ptr = std::realloc(data, (size_t)new_size);
+		LOG_DEBUG(ptr, " = reallocate(", data, ",", new_size, ",", align, ")");
+        return ptr;
+    }
+
 	void* DummyAllocator::allocate(uint64 size, uint32 align)
 	{
 		ARC_ASSERT(size == 0, "trying to allocate memory with dummy allocator");
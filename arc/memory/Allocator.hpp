@@ -17,6 +17,13 @@ public:
     virtual void* allocate(uint64 size, uint32 align = 4) = 0;
     virtual void  free(void* data) = 0;
 
+    /// Resizes the allocation at data without moving it, returns false if not possible.
+    virtual bool  try_expand_in_place(void* data, uint64 old_size, uint64 new_size);
+
+    /// Resizes the allocation at data, moving its content with memcpy if necessary.
+    /// Only use it for memory holding trivially relocatable objects.
+    virtual void* reallocate(void* data, uint64 old_size, uint64 new_size, uint32 align = 4);
+
     template <typename T, typename ...Args> inline
     T* create(Args&& ...args)
     {
@@ -29,6 +36,7 @@ public:
     T* create_n(uint64 n, Args&& ...args)
     {
         void* ptr = allocate(n*sizeof(T),alignof(T));
+        if (ptr == nullptr) return nullptr;
         // inplace constructor
 		for (uint64 i = 0; i < n; i++)
 		{
@@ -61,6 +69,7 @@ class Mallocator final : public Allocator
 public:
     void* allocate(uint64 size, uint32 align = 4) override;
     void  free(void* data) override;
+    void* reallocate(void* data, uint64 old_size, uint64 new_size, uint32 align = 4) override;
 };
 
 class DummyAllocator final : public Allocator
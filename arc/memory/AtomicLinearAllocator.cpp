@@ -0,0 +1,145 @@
+#include "AtomicLinearAllocator.hpp"
+
+#include "arc/memory/util.hpp"
+#include "arc/memory/no_alloc.hpp"
+
+namespace arc { namespace memory {
+
+	namespace
+	{
+		struct ThreadBlock
+		{
+			uint64 serial;
+			char*  current;
+			char*  end;
+		};
+
+		// sub-blocks of the allocators most recently used by this thread
+		const uint32 THREAD_BLOCK_SLOTS = 4;
+		ARC_THREAD_LOCAL ThreadBlock t_blocks[THREAD_BLOCK_SLOTS];
+		ARC_THREAD_LOCAL uint32 t_next_slot;
+
+		std::atomic<uint64> g_next_serial(1);
+
+		inline uint64 round_up(uint64 size)
+		{
+			const uint64 A = AtomicLinearAllocator::MIN_ALIGNMENT;
+			return (size + A - 1) & ~(A - 1);
+		}
+	}
+
+	AtomicLinearAllocator::AtomicLinearAllocator(memory::Allocator* parent, uint64 size, uint32 thread_block_size)
+		: m_parent_alloc(parent)
+		, m_offset(0)
+		, m_thread_block_size((uint32)round_up(thread_block_size))
+		, m_serial(g_next_serial.fetch_add(1))
+	{
+		m_raw = m_parent_alloc->allocate(size + MIN_ALIGNMENT, MIN_ALIGNMENT);
+		if (m_raw == nullptr) size = 0;
+
+		m_begin = (char*)util::forward_align_ptr(m_raw, MIN_ALIGNMENT);
+		m_size = size;
+	}
+
+	AtomicLinearAllocator::~AtomicLinearAllocator()
+	{
+		if (m_parent_alloc != nullptr)
+		{
+			m_parent_alloc->free(m_raw);
+			m_raw = m_begin = nullptr;
+			m_size = 0;
+			m_parent_alloc = nullptr;
+		}
+	}
+
+	void* AtomicLinearAllocator::allocate(uint64 size, uint32 align)
+	{
+		no_alloc::check(size);
+
+		// shared bump pointer
+		if (m_thread_block_size == 0 || size + align > m_thread_block_size / 4)
+		{
+			return reserve(size, align);
+		}
+
+		// look for a sub-block of this allocator owned by the current thread
+		ThreadBlock* tb = nullptr;
+		for (auto& b : t_blocks)
+		{
+			if (b.serial == m_serial) { tb = &b; break; }
+		}
+
+		if (tb != nullptr)
+		{
+			auto aligned = (char*)util::forward_align_ptr(tb->current, align);
+			if (aligned + size <= tb->end)
+			{
+				tb->current = aligned + size;
+				return aligned;
+			}
+		}
+
+		// reserve a new sub-block
+		auto block = (char*)reserve(m_thread_block_size, MIN_ALIGNMENT);
+		if (block == nullptr) return reserve(size, align);
+
+		if (tb == nullptr)
+		{
+			tb = &t_blocks[t_next_slot % THREAD_BLOCK_SLOTS];
+			t_next_slot += 1;
+		}
+
+		auto aligned = (char*)util::forward_align_ptr(block, align);
+		tb->serial = m_serial;
+		tb->current = aligned + size;
+		tb->end = block + m_thread_block_size;
+		return aligned;
+	}
+
+	void AtomicLinearAllocator::free(void* data)
+	{}
+
+	void AtomicLinearAllocator::reset()
+	{
+		m_offset.store(0);
+		m_serial = g_next_serial.fetch_add(1);
+	}
+
+	uint64 AtomicLinearAllocator::used() const
+	{
+		uint64 offset = m_offset.load(std::memory_order_relaxed);
+		return offset < m_size ? offset : m_size;
+	}
+
+	uint64 AtomicLinearAllocator::capacity() const
+	{
+		return m_size;
+	}
+
+	void* AtomicLinearAllocator::reserve(uint64 size, uint32 align)
+	{
+		// the offset always stays a multiple of MIN_ALIGNMENT
+		size = round_up(size);
+
+		if (align <= MIN_ALIGNMENT)
+		{
+			uint64 offset = m_offset.fetch_add(size, std::memory_order_relaxed);
+			if (offset + size > m_size) return nullptr;
+			return m_begin + offset;
+		}
+
+		uint64 offset = m_offset.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			uint64 aligned = (size_t)util::forward_align_ptr(m_begin + offset, align) - (size_t)m_begin;
+			uint64 end = aligned + size;
+			if (end > m_size) return nullptr;
+
+			if (m_offset.compare_exchange_weak(offset, end, std::memory_order_relaxed))
+			{
+				return m_begin + aligned;
+			}
+		}
+	}
+
+}}
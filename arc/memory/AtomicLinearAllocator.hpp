@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+
+#include "arc/core.hpp"
+#include "Allocator.hpp"
+
+namespace arc { namespace memory {
+
+	/* Linear allocator that can be used from several threads at the same time.
+	 *
+	 * The bump offset is advanced with fetch_add (alignments up to MIN_ALIGNMENT) or a
+	 * CAS loop (larger alignments). If thread_block_size is not zero, every thread reserves
+	 * sub-blocks of that size and serves small allocations from them without any atomic
+	 * operation. free() is a no-op and reset() must not run concurrently with allocate(). */
+	class AtomicLinearAllocator final : public Allocator
+	{
+	public:
+		AtomicLinearAllocator(memory::Allocator* parent, uint64 size, uint32 thread_block_size = 0);
+		~AtomicLinearAllocator();
+	public:
+		ARC_NO_COPY(AtomicLinearAllocator);
+	public:
+		void* allocate(uint64 size, uint32 align = 4) override;
+		void  free(void* data) override;
+	public:
+		void reset();
+	public:
+		uint64 used() const;
+		uint64 capacity() const;
+	public:
+		static const uint32 MIN_ALIGNMENT = 16;
+	private:
+		void* reserve(uint64 size, uint32 align);
+	private:
+		memory::Allocator* m_parent_alloc = nullptr;
+		void*  m_raw = nullptr;
+		char*  m_begin = nullptr;
+		uint64 m_size = 0;
+		std::atomic<uint64> m_offset;
+
+		uint32 m_thread_block_size = 0;
+		uint64 m_serial = 0;			// changes with every reset, invalidates the thread sub-blocks
+	};
+
+}}
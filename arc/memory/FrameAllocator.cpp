@@ -0,0 +1,101 @@
+#include "FrameAllocator.hpp"
+
+#include <thread>
+
+namespace arc { namespace memory {
+
+	FrameAllocator::FrameAllocator(memory::Allocator* parent, uint32 size, uint32 frame_count)
+		: m_parent_alloc(parent)
+	{
+		ARC_ASSERT(frame_count > 0 && frame_count <= MAX_FRAME_COUNT, "FrameAllocator: invalid frame count");
+		if (frame_count == 0) frame_count = 1;
+		if (frame_count > MAX_FRAME_COUNT) frame_count = MAX_FRAME_COUNT;
+
+		m_frame_count = frame_count;
+		for (uint32 i = 0; i < MAX_FRAME_COUNT; i++)
+		{
+			auto& slot = m_slots[i];
+			slot.arena = i < m_frame_count ? m_parent_alloc->create<LinearAllocator>(parent, size) : nullptr;
+			slot.frame.store(i, std::memory_order_relaxed);
+			slot.in_flight.store(false, std::memory_order_relaxed);
+		}
+		m_current = 0;
+	}
+
+	FrameAllocator::~FrameAllocator()
+	{
+		if (m_parent_alloc != nullptr)
+		{
+			for (auto& slot : m_slots)
+			{
+				if (slot.arena) m_parent_alloc->destroy(slot.arena);
+				slot.arena = nullptr;
+			}
+			m_parent_alloc = nullptr;
+		}
+	}
+
+	void* FrameAllocator::allocate(uint64 size, uint32 align)
+	{
+		if (m_current == NO_ARENA) return nullptr;
+		return m_slots[m_current].arena->allocate(size, align);
+	}
+
+	void FrameAllocator::free(void* data)
+	{}
+
+	bool FrameAllocator::begin_frame(Counter32 frame, bool wait)
+	{
+		uint32 idx = frame.value() % m_frame_count;
+		auto& slot = m_slots[idx];
+
+		while (slot.in_flight.load(std::memory_order_acquire))
+		{
+			// frame was already started
+			if (Counter32(slot.frame.load(std::memory_order_relaxed)) == frame)
+			{
+				m_current = idx;
+				return true;
+			}
+
+			// the frame that used this arena before is still being consumed
+			if (!wait)
+			{
+				m_current = NO_ARENA;
+				return false;
+			}
+			std::this_thread::yield();
+		}
+
+		slot.arena->reset();
+		slot.frame.store(frame.value(), std::memory_order_relaxed);
+		slot.in_flight.store(true, std::memory_order_release);
+		m_current = idx;
+		return true;
+	}
+
+	void FrameAllocator::retire_frame(Counter32 frame)
+	{
+		auto& slot = m_slots[frame.value() % m_frame_count];
+
+		// the acquire pairs with begin_frame(), the frame stored before in_flight is visible
+		if (!slot.in_flight.load(std::memory_order_acquire)) return;
+
+		// the frame did not get an arena of its own, see begin_frame()
+		if (!(Counter32(slot.frame.load(std::memory_order_relaxed)) == frame)) return;
+
+		slot.in_flight.store(false, std::memory_order_release);
+	}
+
+	uint32 FrameAllocator::frame_count() const
+	{
+		return m_frame_count;
+	}
+
+	LinearAllocator& FrameAllocator::current_arena()
+	{
+		ARC_ASSERT(m_current != NO_ARENA, "FrameAllocator: no frame has been started");
+		return *m_slots[m_current].arena;
+	}
+
+}}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+
+#include "arc/core.hpp"
+#include "arc/util/Counter.hpp"
+#include "LinearAllocator.hpp"
+
+namespace arc { namespace memory {
+
+	/* N-buffered linear allocator for pipelined frames.
+	 *
+	 * Every frame allocates from its own LinearAllocator, selected by the frame counter.
+	 * The memory of a frame stays valid until the consumer calls retire_frame() for it,
+	 * so frame N+1 can be built while frame N is still being consumed. An arena is only
+	 * reset when it is reused by begin_frame(), N frames later. */
+	class FrameAllocator final : public Allocator
+	{
+	public:
+		FrameAllocator(memory::Allocator* parent, uint32 size, uint32 frame_count = 2);
+		~FrameAllocator();
+	public:
+		ARC_NO_COPY(FrameAllocator);
+	public:
+		void* allocate(uint64 size, uint32 align = 4) override;
+		void  free(void* data) override;
+	public:
+		/* Switches allocations to the arena of the given frame. If the frame that used the
+		 * arena before has not been retired yet, waits for the consumer to retire it, or with
+		 * wait = false returns false. Until the next successful call there is no current arena
+		 * then and allocate() returns nullptr, a frame never allocates from another frame's
+		 * arena. Waiting only makes sense if retire_frame() is called from another thread. */
+		bool begin_frame(Counter32 frame, bool wait = true);
+
+		/* Marks the memory of the given frame as no longer in use. Can be called from the
+		 * consuming thread. */
+		void retire_frame(Counter32 frame);
+	public:
+		uint32 frame_count() const;
+		LinearAllocator& current_arena();
+	public:
+		static const uint32 MAX_FRAME_COUNT = 4;
+	private:
+		struct Slot
+		{
+			LinearAllocator*    arena;
+			std::atomic<uint32> frame;			// Counter32 value, published by the store to in_flight
+			std::atomic<bool>   in_flight;
+		};
+	private:
+		memory::Allocator* m_parent_alloc = nullptr;
+		Slot    m_slots[MAX_FRAME_COUNT];
+		uint32  m_frame_count = 0;
+		uint32  m_current = 0;					// NO_ARENA after a failed begin_frame()
+	private:
+		static const uint32 NO_ARENA = ~0u;
+	};
+
+}}
@@ -1,47 +1,225 @@
 #include "LinearAllocator.hpp"
 
 #include "arc/memory/util.hpp"
+#include "arc/memory/no_alloc.hpp"
 
 namespace arc { namespace memory {
 
+	struct LinearAllocator::Block
+	{
+		Block* next;
+		uint64 size;
+
+		inline char* begin() { return (char*)(this + 1); }
+		inline char* end() { return begin() + size; }
+	};
+
 	LinearAllocator::LinearAllocator(memory::Allocator* parent, uint32 size)
 		: m_parent_alloc(parent)
+		, m_block_size(size)
 	{
-		m_begin = (char*)m_parent_alloc->allocate(size);
-		if (m_begin == nullptr) size = 0;
+		m_first = create_block(size);
+		if (m_first == nullptr) return;
 
-		m_current = m_begin;
-		m_end = m_begin + size;
+		m_block = m_first;
+		m_current = m_block->begin();
+		m_end = m_block->end();
 	}
 
-	LinearAllocator::~LinearAllocator() 
-	{ 
+	LinearAllocator::~LinearAllocator()
+	{
 		if (m_parent_alloc != nullptr)
 		{
-			m_parent_alloc->free(m_begin);
-			m_begin = m_current = m_end = nullptr;
+			release_blocks(m_first);
+			m_first = m_block = nullptr;
+			m_current = m_end = nullptr;
 			m_parent_alloc = nullptr;
 		}
 	}
 
 	void* LinearAllocator::allocate(uint64 size, uint32 align)
 	{
+		no_alloc::check(size);
+
 		auto aligned = (char*)memory::util::forward_align((size_t)m_current, align);
 		auto new_front = aligned + size;
 
-		// out of memory
-		if (new_front >= m_end) return nullptr;
+		// out of memory in the current block
+		if (m_block == nullptr || new_front > m_end)
+		{
+			if (!grow(size, align)) return nullptr;
+
+			aligned = (char*)memory::util::forward_align((size_t)m_current, align);
+			new_front = aligned + size;
+		}
 
 		m_current = new_front;
+
+		uint64 used = m_base + (m_current - m_block->begin());
+		if (used > m_peak) m_peak = used;
+
 		return aligned;
 	}
 
 	void LinearAllocator::free(void* data)
 	{}
 
+	bool LinearAllocator::try_expand_in_place(void* data, uint64 old_size, uint64 new_size)
+	{
+		// only the most recent allocation can change its size
+		auto begin = (char*)data;
+		if (begin == nullptr || begin + old_size != m_current) return false;
+		if (begin + new_size > m_end) return false;
+
+		if (new_size > old_size) no_alloc::check(new_size - old_size);
+		m_current = begin + new_size;
+
+		uint64 used = m_base + (m_current - m_block->begin());
+		if (used > m_peak) m_peak = used;
+
+		return true;
+	}
+
+	LinearAllocator::Marker LinearAllocator::get_marker() const
+	{
+		return Marker{ m_block, m_current, m_base };
+	}
+
+	void LinearAllocator::rewind(const Marker& marker)
+	{
+		// blocks behind the marker stay in the chain and are reused by later allocations
+		m_block = marker.block;
+		m_current = marker.current;
+		m_end = m_block ? m_block->end() : nullptr;
+		m_base = marker.base;
+	}
+
 	void LinearAllocator::reset()
 	{
-		m_current = m_begin;
+		if (m_peak > m_high_water) m_high_water = m_peak;
+		if (m_peak > m_window_peak) m_window_peak = m_peak;
+		m_window_count += 1;
+
+		bool rebuild = false;
+		uint64 target = 0;
+
+		// the last cycle did not fit into a single block
+		if (m_first != nullptr && m_first->next != nullptr)
+		{
+			rebuild = true;
+			target = m_peak;
+		}
+		// the block was oversized for a whole window
+		else if (m_window_count >= SHRINK_WINDOW)
+		{
+			if (m_first != nullptr && m_first->size > 2 * m_window_peak && m_first->size > m_block_size)
+			{
+				rebuild = true;
+				target = m_window_peak;
+			}
+			m_window_count = 0;
+			m_window_peak = 0;
+		}
+
+		if (rebuild)
+		{
+			if (target < m_block_size) target = m_block_size;
+			target = memory::util::forward_align(target, 4096);
+
+			release_blocks(m_first);
+			m_first = create_block(target);
+		}
+
+		m_block = m_first;
+		m_current = m_block ? m_block->begin() : nullptr;
+		m_end = m_block ? m_block->end() : nullptr;
+		m_base = 0;
+		m_peak = 0;
+	}
+
+	uint64 LinearAllocator::used() const
+	{
+		return m_block ? m_base + (m_current - m_block->begin()) : 0;
+	}
+
+	uint64 LinearAllocator::peak() const
+	{
+		return m_peak;
+	}
+
+	uint64 LinearAllocator::high_water() const
+	{
+		return m_peak > m_high_water ? m_peak : m_high_water;
+	}
+
+	uint64 LinearAllocator::capacity() const
+	{
+		uint64 sum = 0;
+		for (auto b = m_first; b != nullptr; b = b->next) sum += b->size;
+		return sum;
+	}
+
+	uint32 LinearAllocator::block_count() const
+	{
+		uint32 count = 0;
+		for (auto b = m_first; b != nullptr; b = b->next) count += 1;
+		return count;
+	}
+
+	bool LinearAllocator::grow(uint64 size, uint32 align)
+	{
+		uint64 required = size + align;
+		Block* next = m_block ? m_block->next : m_first;
+
+		// a retained block that is too small is dropped together with everything behind it
+		if (next != nullptr && next->size < required)
+		{
+			if (m_block) m_block->next = nullptr;
+			else m_first = nullptr;
+			release_blocks(next);
+			next = nullptr;
+		}
+
+		if (next == nullptr)
+		{
+			// geometric growth keeps the chain short
+			uint64 block_size = m_block ? 2 * m_block->size : m_block_size;
+			if (block_size < required) block_size = required;
+
+			next = create_block(block_size);
+			if (next == nullptr) return false;
+
+			if (m_block) m_block->next = next;
+			else m_first = next;
+		}
+
+		// the unused tail of the current block counts as consumed
+		if (m_block) m_base += m_block->size;
+
+		m_block = next;
+		m_current = m_block->begin();
+		m_end = m_block->end();
+		return true;
+	}
+
+	LinearAllocator::Block* LinearAllocator::create_block(uint64 size)
+	{
+		auto block = (Block*)m_parent_alloc->allocate(sizeof(Block) + size, alignof(Block));
+		if (block == nullptr) return nullptr;
+
+		block->next = nullptr;
+		block->size = size;
+		return block;
+	}
+
+	void LinearAllocator::release_blocks(Block* first)
+	{
+		while (first != nullptr)
+		{
+			auto next = first->next;
+			m_parent_alloc->free(first);
+			first = next;
+		}
 	}
 
-}}
\ No newline at end of file
+}}
@@ -1,25 +1,84 @@
 #pragma once
 
+#include "arc/core.hpp"
 #include "Allocator.hpp"
 
 namespace arc { namespace memory {
 
+	/* Bump allocator on top of a chain of blocks taken from the parent allocator.
+	 * When the current block is exhausted a new one is chained, so allocations only
+	 * fail if the parent allocator fails. free() is a no-op, memory is reclaimed
+	 * with rewind() or reset(). */
 	class LinearAllocator : public Allocator
 	{
+	public:
+		struct Block;
+
+		/* Position within the allocator, as returned by get_marker(). */
+		struct Marker
+		{
+			Block* block;
+			char*  current;
+			uint64 base;
+		};
+
+		/* Rewinds the allocator to the position at construction when going out of scope.
+		 * Destructors of objects created within the scope are not called. */
+		class Scope
+		{
+		public:
+			inline Scope(LinearAllocator& alloc) : m_alloc(alloc), m_marker(alloc.get_marker()) {}
+			inline ~Scope() { m_alloc.rewind(m_marker); }
+		public:
+			ARC_NO_COPY(Scope);
+		private:
+			LinearAllocator& m_alloc;
+			Marker m_marker;
+		};
+
 	public:
 		LinearAllocator(memory::Allocator* parent, uint32 size);
 		~LinearAllocator();
+	public:
+		ARC_NO_COPY(LinearAllocator);
 	public:
 		void* allocate(uint64 size, uint32 align = 4) override;
 		void  free(void* data) override;
+		bool  try_expand_in_place(void* data, uint64 old_size, uint64 new_size) override;
 	public:
+		Marker get_marker() const;
+		void rewind(const Marker& marker);
+
+		/* Rewinds to the beginning. If the last cycle needed more than one block, the chain is
+		 * replaced by a single block large enough for its peak. A block that stayed much larger
+		 * than needed for SHRINK_WINDOW resets is shrunk to the peak of that window. */
 		void reset();
+	public:
+		uint64 used() const;			// bytes used, including alignment padding and unused block tails
+		uint64 peak() const;			// maximum of used() since the last reset
+		uint64 high_water() const;		// maximum of used() since construction
+		uint64 capacity() const;		// total size of all blocks in the chain
+		uint32 block_count() const;
+	public:
+		static const uint32 SHRINK_WINDOW = 64;
+	private:
+		bool grow(uint64 size, uint32 align);
+		Block* create_block(uint64 size);
+		void release_blocks(Block* first);
 	private:
 		memory::Allocator* m_parent_alloc = nullptr;
-		char*  m_begin = nullptr;
-		char*  m_end = nullptr;
+		uint64 m_block_size = 0;		// minimum block size
+
+		Block* m_first = nullptr;
+		Block* m_block = nullptr;		// block allocations are taken from
 		char*  m_current = nullptr;
-	};
+		char*  m_end = nullptr;
+		uint64 m_base = 0;				// bytes consumed by the blocks in front of m_block
 
+		uint64 m_peak = 0;
+		uint64 m_high_water = 0;
+		uint64 m_window_peak = 0;
+		uint32 m_window_count = 0;
+	};
 
-}}
\ No newline at end of file
+}}
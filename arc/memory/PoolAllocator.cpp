@@ -0,0 +1,130 @@
+#include "PoolAllocator.hpp"
+
+#include "arc/memory/util.hpp"
+#include "arc/memory/no_alloc.hpp"
+
+namespace arc { namespace memory {
+
+	struct PoolAllocator::Page
+	{
+		Page* next;
+	};
+
+	PoolAllocator::PoolAllocator(memory::Allocator* parent, uint32 slot_size, uint32 slot_align, uint32 slots_per_page)
+		: m_parent_alloc(parent)
+	{
+		// every slot must be able to hold a free list link
+		if (slot_align < alignof(FreeSlot)) slot_align = alignof(FreeSlot);
+		if (slot_size < sizeof(FreeSlot)) slot_size = sizeof(FreeSlot);
+		if (slots_per_page == 0) slots_per_page = 1;
+
+		m_slot_align = slot_align;
+		m_slot_size = util::forward_align(slot_size, slot_align);
+		m_slots_per_page = slots_per_page;
+	}
+
+	PoolAllocator::~PoolAllocator()
+	{
+		if (m_parent_alloc != nullptr)
+		{
+			auto page = m_first;
+			while (page != nullptr)
+			{
+				auto next = page->next;
+				m_parent_alloc->free(page);
+				page = next;
+			}
+			m_first = m_page = nullptr;
+			m_free = nullptr;
+			m_parent_alloc = nullptr;
+		}
+	}
+
+	void* PoolAllocator::allocate(uint64 size, uint32 align)
+	{
+		no_alloc::check(size);
+
+		ARC_ASSERT(size <= m_slot_size && align <= m_slot_align, "PoolAllocator: request does not fit the slot size");
+		if (size > m_slot_size || align > m_slot_align) return nullptr;
+
+		// recycled slot
+		if (m_free != nullptr)
+		{
+			auto slot = m_free;
+			m_free = slot->next;
+			m_live_count += 1;
+			return slot;
+		}
+
+		// untouched slot
+		if (m_current == m_end && !next_page()) return nullptr;
+
+		auto slot = m_current;
+		m_current += m_slot_size;
+		m_live_count += 1;
+		return slot;
+	}
+
+	void PoolAllocator::free(void* data)
+	{
+		if (data == nullptr) return;
+
+		auto slot = (FreeSlot*)data;
+		slot->next = m_free;
+		m_free = slot;
+		m_live_count -= 1;
+	}
+
+	void PoolAllocator::clear()
+	{
+		m_free = nullptr;
+		m_page = nullptr;
+		m_current = m_end = nullptr;
+		m_live_count = 0;
+	}
+
+	uint32 PoolAllocator::slot_size() const
+	{
+		return m_slot_size;
+	}
+
+	uint32 PoolAllocator::live_count() const
+	{
+		return m_live_count;
+	}
+
+	uint32 PoolAllocator::capacity() const
+	{
+		return m_page_count * m_slots_per_page;
+	}
+
+	uint32 PoolAllocator::page_count() const
+	{
+		return m_page_count;
+	}
+
+	bool PoolAllocator::next_page()
+	{
+		// reuse the pages kept by clear() before asking the parent
+		Page* page = m_page != nullptr ? m_page->next : m_first;
+
+		if (page == nullptr)
+		{
+			// the parent might not honour the alignment, leave room to align the first slot
+			uint64 size = sizeof(Page) + m_slot_align + (uint64)m_slot_size * m_slots_per_page;
+			page = (Page*)m_parent_alloc->allocate(size, alignof(Page));
+			if (page == nullptr) return false;
+
+			page->next = nullptr;
+			if (m_page != nullptr) m_page->next = page;
+			else m_first = page;
+			m_page_count += 1;
+		}
+
+		m_page = page;
+		m_current = (char*)util::forward_align_ptr(page + 1, m_slot_align);
+		m_end = m_current + (uint64)m_slot_size * m_slots_per_page;
+		return true;
+	}
+
+}}
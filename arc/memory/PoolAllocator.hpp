@@ -0,0 +1,92 @@
+#pragma once
+
+#include "arc/core.hpp"
+#include "Allocator.hpp"
+
+namespace arc { namespace memory {
+
+	/* Allocator for fixed-size slots.
+	 *
+	 * Slots are carved out of pages taken from the parent allocator. Freed slots are kept
+	 * in an intrusive free list, so allocate() and free() are O(1). Requests larger than
+	 * the slot size or with a stricter alignment fail. Pages are only returned to the
+	 * parent when the PoolAllocator is destroyed. */
+	class PoolAllocator final : public Allocator
+	{
+	public:
+		PoolAllocator(memory::Allocator* parent, uint32 slot_size, uint32 slot_align = 8, uint32 slots_per_page = 64);
+		~PoolAllocator();
+	public:
+		ARC_NO_COPY(PoolAllocator);
+	public:
+		void* allocate(uint64 size, uint32 align = 4) override;
+		void  free(void* data) override;
+	public:
+		/* Marks every slot as free, the pages are kept. */
+		void clear();
+	public:
+		uint32 slot_size() const;
+		uint32 live_count() const;		// slots currently allocated
+		uint32 capacity() const;		// slots in all pages
+		uint32 page_count() const;
+	private:
+		struct Page;
+		struct FreeSlot
+		{
+			FreeSlot* next;
+		};
+	private:
+		bool next_page();
+	private:
+		memory::Allocator* m_parent_alloc = nullptr;
+		uint32 m_slot_size = 0;
+		uint32 m_slot_align = 0;
+		uint32 m_slots_per_page = 0;
+
+		FreeSlot* m_free = nullptr;
+		Page*  m_first = nullptr;
+		Page*  m_page = nullptr;		// page untouched slots are taken from
+		char*  m_current = nullptr;
+		char*  m_end = nullptr;
+
+		uint32 m_live_count = 0;
+		uint32 m_page_count = 0;
+	};
+
+	/* Typed wrapper around a PoolAllocator. */
+	template<typename T>
+	class ObjectPool
+	{
+	public:
+		inline ObjectPool(memory::Allocator* parent, uint32 objects_per_page = 64)
+			: m_pool(parent, sizeof(T), alignof(T), objects_per_page)
+		{}
+	public:
+		ARC_NO_COPY(ObjectPool);
+	public:
+		template<typename ...Args>
+		inline T* create(Args&& ...args)
+		{
+			void* ptr = m_pool.allocate(sizeof(T), alignof(T));
+			if (ptr == nullptr) return nullptr;
+			return new (ptr) T(std::forward<Args>(args)...);
+		}
+
+		inline void destroy(T* object)
+		{
+			if (object == nullptr) return;
+			object->~T();
+			m_pool.free(object);
+		}
+
+		/* Releases all objects at once. Destructors are not called. */
+		inline void clear() { m_pool.clear(); }
+	public:
+		inline uint32 live_count() const { return m_pool.live_count(); }
+		inline uint32 capacity() const { return m_pool.capacity(); }
+		inline PoolAllocator& allocator() { return m_pool; }
+	private:
+		PoolAllocator m_pool;
+	};
+
+}}
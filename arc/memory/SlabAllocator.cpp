@@ -0,0 +1,367 @@
+#include "SlabAllocator.hpp"
+
+#include "arc/core.hpp"
+#include "arc/memory/util.hpp"
+#include "arc/memory/no_alloc.hpp"
+#include "arc/collections/Array.inl"
+
+#include <atomic>
+
+#ifdef _WIN32
+	#include <intrin.h>
+#endif
+
+namespace arc { namespace memory {
+
+	namespace
+	{
+		/* Sits at the beginning of every slab and of every large allocation, so the
+		   header of any pointer handed out can be found by masking its address. */
+		struct SlabHeader
+		{
+			uint32         magic;
+			uint32         size_class;
+			SlabAllocator* owner;
+			void*          raw;			// parent allocation, only used by large allocations
+		};
+
+		const uint32 SLAB_MAGIC = 0x51AB51AB;
+		const uint32 LARGE_CLASS = (uint32)-1;
+
+		const uint32 MAX_THREAD_CACHE_SLOTS = 32;
+
+		// slots for SlabAllocator instances that are alive at the same time
+		std::atomic<uint32> g_used_slots(0);
+		std::atomic<uint64> g_next_serial(1);
+
+		// per thread caches, indexed by the slot of the owning instance
+		ARC_THREAD_LOCAL uint64 t_cache_serials[MAX_THREAD_CACHE_SLOTS];
+		ARC_THREAD_LOCAL void*  t_caches[MAX_THREAD_CACHE_SLOTS];
+
+		inline uint32 ceil_log2(uint32 v)
+		{
+			if (v <= 1) return 0;
+#ifdef _WIN32
+			unsigned long idx;
+			_BitScanReverse(&idx, v - 1);
+			return idx + 1;
+#else
+			return 32 - __builtin_clz(v - 1);
+#endif
+		}
+
+		inline uint32 size_class(uint64 request)
+		{
+			uint32 shift = ceil_log2((uint32)request);
+			if (shift < SlabAllocator::MIN_CLASS_SHIFT) shift = SlabAllocator::MIN_CLASS_SHIFT;
+			return shift - SlabAllocator::MIN_CLASS_SHIFT;
+		}
+
+		inline uint32 block_size(uint32 size_class)
+		{
+			return 1u << (size_class + SlabAllocator::MIN_CLASS_SHIFT);
+		}
+
+		inline uint32 batch_size(uint32 size_class)
+		{
+			uint32 n = SlabAllocator::BATCH_BYTES / block_size(size_class);
+			if (n < 2) return 2;
+			if (n > 64) return 64;
+			return n;
+		}
+
+		inline SlabHeader* slab_header(void* data)
+		{
+			return (SlabHeader*)((size_t)data & ~(size_t)(SlabAllocator::SLAB_SIZE - 1));
+		}
+
+		int32 acquire_slot()
+		{
+			uint32 used = g_used_slots.load();
+			for (;;)
+			{
+				int32 slot = -1;
+				for (uint32 i = 0; i < MAX_THREAD_CACHE_SLOTS; i++)
+				{
+					if ((used & (1u << i)) == 0) { slot = i; break; }
+				}
+				if (slot < 0) return -1;
+				if (g_used_slots.compare_exchange_weak(used, used | (1u << slot))) return slot;
+			}
+		}
+
+		void release_slot(int32 slot)
+		{
+			if (slot >= 0) g_used_slots.fetch_and(~(1u << slot));
+		}
+	}
+
+	SlabAllocator::SlabAllocator(memory::Allocator* parent)
+		: m_parent_alloc(parent)
+		, m_chunks(*parent)
+	{
+		for (auto& b : m_batches) b = nullptr;
+		for (auto& l : m_shared_cache.lists) { l.head = nullptr; l.count = 0; }
+		m_shared_cache.next = nullptr;
+
+		m_slot = acquire_slot();
+		m_serial = g_next_serial.fetch_add(1);
+	}
+
+	SlabAllocator::~SlabAllocator()
+	{
+		release_slot(m_slot);
+		m_slot = -1;
+
+		// thread caches
+		while (m_caches != nullptr)
+		{
+			auto next = m_caches->next;
+			m_parent_alloc->free(m_caches);
+			m_caches = next;
+		}
+
+		// slab memory
+		for (auto chunk : m_chunks) m_parent_alloc->free(chunk);
+		m_chunks.finalize();
+
+		m_slab_current = m_slab_end = nullptr;
+		m_parent_alloc = nullptr;
+	}
+
+	void* SlabAllocator::allocate(uint64 size, uint32 align)
+	{
+		no_alloc::check(size);
+
+		uint64 request = size > align ? size : align;
+		if (request > block_size(CLASS_COUNT - 1)) return allocate_large(size, align);
+
+		uint32 sc = size_class(request);
+
+		auto cache = thread_cache();
+		if (cache != nullptr) return pop_block(cache->lists[sc], sc);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto& list = m_shared_cache.lists[sc];
+		if (list.head == nullptr) refill_locked(list, sc);
+		if (list.head == nullptr) return nullptr;
+
+		auto block = list.head;
+		list.head = block->next;
+		list.count -= 1;
+		return block;
+	}
+
+	bool SlabAllocator::try_expand_in_place(void* data, uint64 old_size, uint64 new_size)
+	{
+		if (data == nullptr) return false;
+
+		// the block is large enough as long as the request stays in its size class
+		auto header = slab_header(data);
+		if (header->size_class == LARGE_CLASS || new_size > block_size(header->size_class)) return false;
+
+		return true;
+	}
+
+	void SlabAllocator::free(void* data)
+	{
+		if (data == nullptr) return;
+
+		auto header = slab_header(data);
+		ARC_ASSERT(header->magic == SLAB_MAGIC && header->owner == this, "SlabAllocator: pointer was not allocated by this allocator");
+
+		if (header->size_class == LARGE_CLASS)
+		{
+			header->magic = 0;
+			m_parent_alloc->free(header->raw);
+			return;
+		}
+
+		uint32 sc = header->size_class;
+
+		auto cache = thread_cache();
+		if (cache != nullptr)
+		{
+			push_block(cache->lists[sc], sc, data);
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto& list = m_shared_cache.lists[sc];
+		auto block = (FreeBlock*)data;
+		block->next = list.head;
+		list.head = block;
+		list.count += 1;
+		if (list.count >= 2 * batch_size(sc))
+		{
+			auto batch = detach_batch(list, sc);
+			batch->next_batch = m_batches[sc];
+			m_batches[sc] = batch;
+		}
+	}
+
+	void* SlabAllocator::allocate_large(uint64 size, uint32 align)
+	{
+		ARC_ASSERT(align <= SLAB_SIZE / 2, "SlabAllocator: alignment too large");
+
+		// over-allocate, so that the header can be placed on a slab boundary in front of the data
+		uint64 total = size + SLAB_SIZE + sizeof(SlabHeader) + align;
+		void* raw = m_parent_alloc->allocate(total, alignof(SlabHeader));
+		if (raw == nullptr) return nullptr;
+
+		auto header = (SlabHeader*)util::forward_align_ptr(raw, SLAB_SIZE);
+		header->magic = SLAB_MAGIC;
+		header->size_class = LARGE_CLASS;
+		header->owner = this;
+		header->raw = raw;
+
+		return util::forward_align_ptr(header + 1, align);
+	}
+
+	SlabAllocator::ThreadCache* SlabAllocator::thread_cache()
+	{
+		if (m_slot < 0) return nullptr;
+		if (t_cache_serials[m_slot] == m_serial) return (ThreadCache*)t_caches[m_slot];
+
+		// first use of this allocator on the current thread
+		ThreadCache* cache = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			cache = (ThreadCache*)m_parent_alloc->allocate(sizeof(ThreadCache), alignof(ThreadCache));
+			if (cache == nullptr) return nullptr;
+
+			for (auto& l : cache->lists) { l.head = nullptr; l.count = 0; }
+			cache->next = m_caches;
+			m_caches = cache;
+		}
+
+		t_cache_serials[m_slot] = m_serial;
+		t_caches[m_slot] = cache;
+		return cache;
+	}
+
+	void* SlabAllocator::pop_block(FreeList& list, uint32 sc)
+	{
+		if (list.head == nullptr)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			refill_locked(list, sc);
+			if (list.head == nullptr) return nullptr;
+		}
+
+		auto block = list.head;
+		list.head = block->next;
+		list.count -= 1;
+		return block;
+	}
+
+	void SlabAllocator::push_block(FreeList& list, uint32 sc, void* data)
+	{
+		auto block = (FreeBlock*)data;
+		block->next = list.head;
+		list.head = block;
+		list.count += 1;
+
+		// return a batch to the depot, if this thread holds on to too many blocks
+		if (list.count >= 2 * batch_size(sc))
+		{
+			auto batch = detach_batch(list, sc);
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			batch->next_batch = m_batches[sc];
+			m_batches[sc] = batch;
+		}
+	}
+
+	SlabAllocator::FreeBlock* SlabAllocator::detach_batch(FreeList& list, uint32 sc)
+	{
+		uint32 n = batch_size(sc);
+		ARC_ASSERT(list.count >= n, "SlabAllocator: not enough blocks for a batch");
+
+		auto first = list.head;
+		auto last = first;
+		for (uint32 i = 1; i < n; i++) last = last->next;
+
+		list.head = last->next;
+		list.count -= n;
+		last->next = nullptr;
+		return first;
+	}
+
+	void SlabAllocator::refill_locked(FreeList& list, uint32 sc)
+	{
+		// take a full batch from the depot
+		auto batch = m_batches[sc];
+		if (batch != nullptr)
+		{
+			m_batches[sc] = batch->next_batch;
+			list.head = batch;
+			list.count = batch_size(sc);
+			return;
+		}
+
+		// carve a fresh slab
+		char* slab = take_slab_locked();
+		if (slab == nullptr) return;
+
+		auto header = (SlabHeader*)slab;
+		header->magic = SLAB_MAGIC;
+		header->size_class = sc;
+		header->owner = this;
+		header->raw = nullptr;
+
+		uint32 bs = block_size(sc);
+		uint32 n = batch_size(sc);
+		char* begin = (char*)util::forward_align_ptr(slab + sizeof(SlabHeader), bs);
+		uint32 block_count = (uint32)((slab + SLAB_SIZE - begin) / bs);
+
+		// full batches go to the depot, the remainder goes to the requesting list
+		uint32 batch_count = block_count / n;
+		uint32 remainder = block_count - batch_count * n;
+		if (batch_count > 0 && remainder == 0) { batch_count -= 1; remainder = n; }
+
+		char* current = begin;
+		for (uint32 b = 0; b < batch_count; b++)
+		{
+			auto first = (FreeBlock*)current;
+			for (uint32 i = 0; i < n; i++)
+			{
+				auto block = (FreeBlock*)current;
+				current += bs;
+				block->next = i + 1 < n ? (FreeBlock*)current : nullptr;
+			}
+			first->next_batch = m_batches[sc];
+			m_batches[sc] = first;
+		}
+
+		list.head = remainder > 0 ? (FreeBlock*)current : nullptr;
+		list.count = remainder;
+		for (uint32 i = 0; i < remainder; i++)
+		{
+			auto block = (FreeBlock*)current;
+			current += bs;
+			block->next = i + 1 < remainder ? (FreeBlock*)current : nullptr;
+		}
+	}
+
+	char* SlabAllocator::take_slab_locked()
+	{
+		if (m_slab_current == m_slab_end)
+		{
+			// request a new chunk, one slab larger than needed to be able to align the slabs
+			uint64 chunk_size = (uint64)(SLABS_PER_CHUNK + 1) * SLAB_SIZE;
+			void* raw = m_parent_alloc->allocate(chunk_size, 16);
+			if (raw == nullptr) return nullptr;
+			m_chunks.push_back(raw);
+
+			size_t raw_end = (size_t)raw + (size_t)chunk_size;
+			m_slab_current = (char*)util::forward_align_ptr(raw, SLAB_SIZE);
+			m_slab_end = (char*)(raw_end & ~(size_t)(SLAB_SIZE - 1));
+		}
+
+		char* slab = m_slab_current;
+		m_slab_current += SLAB_SIZE;
+		return slab;
+	}
+
+}} // namespace arc::memory
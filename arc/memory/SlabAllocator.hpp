@@ -0,0 +1,84 @@
+#pragma once
+
+#include <mutex>
+
+#include "Allocator.hpp"
+#include "arc/collections/Array.hpp"
+
+namespace arc { namespace memory {
+
+	/* General purpose allocator for small objects.
+	 *
+	 * Requests are rounded up to power-of-two size classes (16 bytes to 8KB) and served
+	 * from 64KB slabs that are carved out of chunks taken from the parent allocator. Every
+	 * thread keeps a short free list per size class, so most allocate/free calls never touch
+	 * the shared depot and its lock. Blocks are moved between the thread caches and the
+	 * depot in batches.
+	 *
+	 * Blocks of size class 2^k are aligned to 2^k, so alignment is honoured by rounding
+	 * the request up to the alignment. Larger requests are forwarded to the parent allocator.
+	 *
+	 * Slabs are never returned to the parent before the SlabAllocator is destroyed. */
+	class SlabAllocator final : public Allocator
+	{
+	public:
+		SlabAllocator(memory::Allocator* parent);
+		~SlabAllocator();
+	public:
+		ARC_NO_COPY(SlabAllocator);
+	public:
+		void* allocate(uint64 size, uint32 align = 4) override;
+		void  free(void* data) override;
+		bool  try_expand_in_place(void* data, uint64 old_size, uint64 new_size) override;
+	public:
+		static const uint32 SLAB_SIZE = 64 * 1024;		// 64KB, slabs are aligned to their size
+		static const uint32 SLABS_PER_CHUNK = 16;		// slabs requested from the parent at once
+		static const uint32 MIN_CLASS_SHIFT = 4;		// 16 bytes
+		static const uint32 MAX_CLASS_SHIFT = 13;		// 8KB
+		static const uint32 CLASS_COUNT = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+		static const uint32 BATCH_BYTES = 8 * 1024;		// amount of memory moved between thread cache and depot
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next;
+			FreeBlock* next_batch;
+		};
+
+		struct FreeList
+		{
+			FreeBlock* head;
+			uint32     count;
+		};
+
+		struct ThreadCache
+		{
+			FreeList     lists[CLASS_COUNT];
+			ThreadCache* next;
+		};
+	private:
+		void* allocate_large(uint64 size, uint32 align);
+		ThreadCache* thread_cache();
+	private:
+		void* pop_block(FreeList& list, uint32 size_class);
+		void  push_block(FreeList& list, uint32 size_class, void* data);
+		void  refill_locked(FreeList& list, uint32 size_class);
+		FreeBlock* detach_batch(FreeList& list, uint32 size_class);
+		char* take_slab_locked();
+	private:
+		memory::Allocator* m_parent_alloc = nullptr;
+		std::mutex         m_mutex;
+
+		// depot, guarded by m_mutex
+		FreeBlock*   m_batches[CLASS_COUNT];
+		Array<void*> m_chunks;
+		char*        m_slab_current = nullptr;
+		char*        m_slab_end = nullptr;
+		ThreadCache* m_caches = nullptr;
+		ThreadCache  m_shared_cache;			// used by threads that could not get a thread cache slot
+
+		// thread cache registration
+		int32  m_slot = -1;
+		uint64 m_serial = 0;
+	};
+
+}}
@@ -0,0 +1,200 @@
+#include "StackAllocator.hpp"
+
+#include "arc/memory/util.hpp"
+#include "arc/memory/no_alloc.hpp"
+
+namespace arc { namespace memory {
+
+	StackAllocator::StackAllocator(memory::Allocator* parent, uint32 size)
+		: m_parent_alloc(parent)
+		, m_top_alloc(*this)
+	{
+		ARC_ASSERT(size < NONE, "StackAllocator: size must be below 2GB");
+		if (size >= NONE) size = NONE - 1;
+
+		m_begin = (char*)m_parent_alloc->allocate(size, 16);
+		m_size = m_begin != nullptr ? size : 0;
+		reset();
+	}
+
+	StackAllocator::~StackAllocator()
+	{
+		if (m_parent_alloc != nullptr)
+		{
+			m_parent_alloc->free(m_begin);
+			m_begin = nullptr;
+			m_size = m_bottom = m_top = 0;
+			m_parent_alloc = nullptr;
+		}
+	}
+
+	void* StackAllocator::allocate(uint64 size, uint32 align)
+	{
+		return allocate(End::BOTTOM, size, align);
+	}
+
+	void* StackAllocator::allocate(End end, uint64 size, uint32 align)
+	{
+		no_alloc::check(size);
+
+		if (align < alignof(Header)) align = alignof(Header);
+		size_t base = (size_t)m_begin;
+
+		if (end == End::BOTTOM)
+		{
+			size_t data = util::forward_align(base + m_bottom + sizeof(Header), (size_t)align);
+			uint64 new_bottom = (data - base) + size;
+			if (new_bottom > m_top) return nullptr;
+
+			auto header = (Header*)(data - sizeof(Header));
+			header->prev_offset = m_bottom;
+			header->prev_last = m_bottom_last;
+
+			m_bottom = (uint32)new_bottom;
+			m_bottom_last = (uint32)((size_t)header - base);
+			if (m_bottom > m_bottom_peak) m_bottom_peak = m_bottom;
+			return (void*)data;
+		}
+		else
+		{
+			if (size + sizeof(Header) + align > m_top) return nullptr;
+
+			size_t data = (base + m_top - size) / align * align;
+			size_t header_addr = data - sizeof(Header);
+			if (header_addr < base + m_bottom) return nullptr;
+
+			auto header = (Header*)header_addr;
+			header->prev_offset = m_top;
+			header->prev_last = m_top_last;
+
+			m_top = (uint32)(header_addr - base);
+			m_top_last = m_top;
+			if (m_size - m_top > m_top_peak) m_top_peak = m_size - m_top;
+			return (void*)data;
+		}
+	}
+
+	void StackAllocator::free(void* data)
+	{
+		if (data == nullptr) return;
+
+		auto header = (Header*)((char*)data - sizeof(Header));
+		uint32 offset = (uint32)((char*)header - m_begin);
+		End end = offset < m_bottom ? End::BOTTOM : End::TOP;
+		uint32 last = end == End::BOTTOM ? m_bottom_last : m_top_last;
+
+		ARC_ASSERT((header->prev_last & FREED_BIT) == 0, "StackAllocator: double free");
+		ARC_ASSERT(end == End::BOTTOM || offset >= m_top, "StackAllocator: freeing memory that is not allocated");
+
+		// not the most recent allocation, reclaimed together with the allocations above it
+		if (offset != last)
+		{
+			header->prev_last |= FREED_BIT;
+			return;
+		}
+
+		pop(end);
+	}
+
+	bool StackAllocator::try_expand_in_place(void* data, uint64 old_size, uint64 new_size)
+	{
+		if (data == nullptr) return false;
+
+		// only the most recent bottom allocation can change its size, the top grows downwards
+		uint32 offset = (uint32)((char*)data - sizeof(Header) - m_begin);
+		if (offset >= m_bottom || offset != m_bottom_last) return false;
+
+		uint64 begin = (char*)data - m_begin;
+		if (begin + new_size > m_top) return false;
+
+		if (new_size > old_size) no_alloc::check(new_size - old_size);
+		m_bottom = (uint32)(begin + new_size);
+		if (m_bottom > m_bottom_peak) m_bottom_peak = m_bottom;
+		return true;
+	}
+
+	void StackAllocator::pop(End end)
+	{
+		uint32& pos = end == End::BOTTOM ? m_bottom : m_top;
+		uint32& last = end == End::BOTTOM ? m_bottom_last : m_top_last;
+
+		do
+		{
+			auto header = (Header*)(m_begin + last);
+			pos = header->prev_offset;
+			last = header->prev_last & ~FREED_BIT;
+		}
+		while (last != NONE && (((Header*)(m_begin + last))->prev_last & FREED_BIT) != 0);
+	}
+
+	memory::Allocator& StackAllocator::top()
+	{
+		return m_top_alloc;
+	}
+
+	StackAllocator::Marker StackAllocator::get_marker(End end) const
+	{
+		Marker marker;
+		marker.end = end;
+		marker.offset = end == End::BOTTOM ? m_bottom : m_top;
+		marker.last = end == End::BOTTOM ? m_bottom_last : m_top_last;
+		return marker;
+	}
+
+	void StackAllocator::rewind(const Marker& marker)
+	{
+		if (marker.end == End::BOTTOM)
+		{
+			ARC_ASSERT(marker.offset <= m_bottom, "StackAllocator: marker is ahead of the bottom end");
+			m_bottom = marker.offset;
+			m_bottom_last = marker.last;
+		}
+		else
+		{
+			ARC_ASSERT(marker.offset >= m_top, "StackAllocator: marker is ahead of the top end");
+			m_top = marker.offset;
+			m_top_last = marker.last;
+		}
+	}
+
+	void StackAllocator::reset(End end)
+	{
+		if (end == End::BOTTOM)
+		{
+			m_bottom = 0;
+			m_bottom_last = NONE;
+		}
+		else
+		{
+			m_top = m_size;
+			m_top_last = NONE;
+		}
+	}
+
+	void StackAllocator::reset()
+	{
+		reset(End::BOTTOM);
+		reset(End::TOP);
+	}
+
+	uint64 StackAllocator::used(End end) const
+	{
+		return end == End::BOTTOM ? m_bottom : m_size - m_top;
+	}
+
+	uint64 StackAllocator::peak(End end) const
+	{
+		return end == End::BOTTOM ? m_bottom_peak : m_top_peak;
+	}
+
+	uint64 StackAllocator::remaining() const
+	{
+		return m_top - m_bottom;
+	}
+
+	uint64 StackAllocator::capacity() const
+	{
+		return m_size;
+	}
+
+}}
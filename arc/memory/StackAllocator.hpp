@@ -0,0 +1,92 @@
+#pragma once
+
+#include "arc/core.hpp"
+#include "Allocator.hpp"
+
+namespace arc { namespace memory {
+
+	/* Double-ended stack on top of a single block taken from the parent allocator.
+	 *
+	 * Long-lived data is allocated from the bottom, temporaries from the top; both ends grow
+	 * towards each other and allocations fail when they meet. free() finds the end from the
+	 * address and releases memory in LIFO order; a block freed out of order is reclaimed as
+	 * soon as everything allocated after it on the same end is freed. rewind() and reset()
+	 * release a whole range at once. The Allocator interface allocates from the bottom,
+	 * top() returns an Allocator that allocates from the top. */
+	class StackAllocator final : public Allocator
+	{
+	public:
+		enum class End : uint8
+		{
+			BOTTOM = 0,
+			TOP = 1,
+		};
+
+		/* Position of one end, as returned by get_marker(). */
+		struct Marker
+		{
+			uint32 offset;
+			uint32 last;
+			End    end;
+		};
+
+	public:
+		/* size must be below 2GB */
+		StackAllocator(memory::Allocator* parent, uint32 size);
+		~StackAllocator();
+	public:
+		ARC_NO_COPY(StackAllocator);
+	public:
+		void* allocate(uint64 size, uint32 align = 4) override;
+		void  free(void* data) override;
+		bool  try_expand_in_place(void* data, uint64 old_size, uint64 new_size) override;
+	public:
+		void* allocate(End end, uint64 size, uint32 align = 4);
+		memory::Allocator& top();
+	public:
+		static const uint32 NONE = 0x7FFFFFFF;
+		static const uint32 FREED_BIT = 0x80000000;
+	public:
+		Marker get_marker(End end) const;
+		void rewind(const Marker& marker);
+		void reset(End end);
+		void reset();
+	public:
+		uint64 used(End end) const;		// bytes used by one end, including headers and padding
+		uint64 peak(End end) const;		// maximum of used(end) since construction
+		uint64 remaining() const;		// bytes between the two ends
+		uint64 capacity() const;
+	private:
+		struct Header
+		{
+			uint32 prev_offset;			// position of the end before the allocation
+			uint32 prev_last;			// header of the previous allocation on the same end, FREED_BIT if freed
+		};
+
+		class TopAllocator final : public Allocator
+		{
+		public:
+			inline TopAllocator(StackAllocator& stack) : m_stack(stack) {}
+			inline void* allocate(uint64 size, uint32 align = 4) override { return m_stack.allocate(End::TOP, size, align); }
+			inline void  free(void* data) override { m_stack.free(data); }
+		private:
+			StackAllocator& m_stack;
+		};
+	private:
+		void pop(End end);
+	private:
+		memory::Allocator* m_parent_alloc = nullptr;
+		char*  m_begin = nullptr;
+		uint32 m_size = 0;
+
+		uint32 m_bottom = 0;			// offset of the first free byte above the bottom stack
+		uint32 m_top = 0;				// offset of the first byte of the top stack
+		uint32 m_bottom_last = NONE;	// header of the most recent allocation on each end
+		uint32 m_top_last = NONE;
+		uint32 m_bottom_peak = 0;
+		uint32 m_top_peak = 0;
+
+		TopAllocator m_top_alloc;
+	};
+
+}}
@@ -0,0 +1,170 @@
+#include "TraceAllocator.hpp"
+
+#include <atomic>
+
+#include "arc/collections/Array.inl"
+#include "arc/collections/HashMap.inl"
+#include "arc/io/FileStream.hpp"
+#include "arc/logging/log.hpp"
+
+namespace arc { namespace memory {
+
+	namespace
+	{
+		std::atomic<uint32> g_next_thread(0);
+		ARC_THREAD_LOCAL uint32 t_thread;		// 0 until the thread made its first call
+
+		inline uint8 thread_number()
+		{
+			if (t_thread == 0) t_thread = g_next_thread.fetch_add(1) + 1;
+			return t_thread > 255 ? 255 : (uint8)(t_thread - 1);
+		}
+
+		inline uint8 align_shift(uint32 align)
+		{
+			uint8 shift = 0;
+			while (shift < 31 && (1u << shift) < align) shift++;
+			return shift;
+		}
+	}
+
+	TraceAllocator::TraceAllocator(memory::Allocator* parent, memory::Allocator* event_alloc)
+		: m_parent_alloc(parent)
+		, m_events(*event_alloc)
+		, m_live_blocks(*event_alloc)
+	{}
+
+	TraceAllocator::~TraceAllocator()
+	{
+		m_parent_alloc = nullptr;
+	}
+
+	void* TraceAllocator::allocate(uint64 size, uint32 align)
+	{
+		void* data = m_parent_alloc->allocate(size, align);
+		if (data == nullptr) return nullptr;
+
+		Event e;
+		e.size = size > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32)size;
+		e.op = Op::ALLOCATE;
+		e.thread = thread_number();
+		e.align_shift = align_shift(align);
+		e.reserved = 0;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		e.id = m_next_id++;
+		m_live_blocks.set((uint64)data, e);
+		m_events.push_back(e);
+		return data;
+	}
+
+	void TraceAllocator::free(void* data)
+	{
+		if (data == nullptr) return;
+
+		Event e;
+		e.size = 0;
+		e.op = Op::FREE;
+		e.thread = thread_number();
+		e.align_shift = 0;
+		e.reserved = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto entry = m_live_blocks.lookup((uint64)data);
+			ARC_ASSERT(entry != nullptr, "TraceAllocator: freeing unknown pointer");
+			if (entry != nullptr)
+			{
+				e.id = entry->value().id;
+				m_live_blocks.remove((uint64)data);
+				m_events.push_back(e);
+			}
+		}
+
+		m_parent_alloc->free(data);
+	}
+
+	const Array<TraceAllocator::Event>& TraceAllocator::events() const
+	{
+		return m_events;
+	}
+
+	uint32 TraceAllocator::allocation_count() const
+	{
+		return m_next_id;
+	}
+
+	void TraceAllocator::clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_events.clear();
+		m_next_id = 0;
+
+		for (auto& entry : m_live_blocks)
+		{
+			Event& e = entry.value();
+			e.id = m_next_id++;
+			m_events.push_back(e);
+		}
+	}
+
+	bool TraceAllocator::save(io::BinaryWriteStream& out)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		FileHeader header;
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.event_count = m_events.size();
+		header.allocation_count = m_next_id;
+
+		uint64 bytes = sizeof(Event) * (uint64)m_events.size();
+		if (out.write(&header, sizeof(FileHeader)) != sizeof(FileHeader)) return false;
+		if (bytes > 0 && out.write(m_events.data(), bytes) != bytes) return false;
+		return true;
+	}
+
+	bool TraceAllocator::load(io::BinaryReadStream& in, Array<Event>& o_events, uint32& o_allocation_count)
+	{
+		FileHeader header;
+		if (in.read(&header, sizeof(FileHeader)) != sizeof(FileHeader)) return false;
+		if (header.magic != MAGIC || header.version != VERSION)
+		{
+			LOG_ERROR("Invalid allocation trace header");
+			return false;
+		}
+
+		uint64 bytes = sizeof(Event) * (uint64)header.event_count;
+		if (in.supports_seek() && in.supports_tell())
+		{
+			uint64 position = in.tell();
+			uint64 size = in.seek_end();
+			in.seek_start(position);
+			if (size < position || size - position < bytes)
+			{
+				LOG_ERROR("Allocation trace is truncated, expected ", header.event_count, " events");
+				return false;
+			}
+		}
+
+		o_events.resize(header.event_count);
+		if (bytes > 0 && in.read(o_events.data(), bytes) != bytes) return false;
+
+		for (uint32 i = 0; i < o_events.size(); i++)
+		{
+			const Event& e = o_events[i];
+			bool valid = e.id < header.allocation_count && e.align_shift < 32
+				&& (e.op == Op::ALLOCATE || e.op == Op::FREE);
+			if (!valid)
+			{
+				LOG_ERROR("Invalid allocation trace event ", i, ": id ", e.id, " op ", (uint32)e.op);
+				o_events.clear();
+				return false;
+			}
+		}
+
+		o_allocation_count = header.allocation_count;
+		return true;
+	}
+
+}}
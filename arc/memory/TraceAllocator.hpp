@@ -0,0 +1,78 @@
+#pragma once
+
+#include <mutex>
+
+#include "arc/core.hpp"
+#include "arc/collections/Array.hpp"
+#include "arc/collections/HashMap.hpp"
+#include "Allocator.hpp"
+
+namespace arc { namespace io { class BinaryReadStream; class BinaryWriteStream; } }
+
+namespace arc { namespace memory {
+
+	/* Decorator that records every allocate() and free() going through it.
+	 *
+	 * Allocations are numbered in the order they are made; a free refers to that number, so
+	 * the trace captures sizes, alignments, lifetimes and the calling thread but no addresses.
+	 * The trace can be saved to a compact binary stream and replayed against any allocator,
+	 * see playground/benchmark/replay_benchmark.cpp. Recording takes a lock per call. */
+	class TraceAllocator final : public Allocator
+	{
+	public:
+		enum class Op : uint8
+		{
+			ALLOCATE = 0,
+			FREE = 1,
+		};
+
+		struct Event
+		{
+			uint32 id;				// number of the allocation
+			uint32 size;
+			Op     op;
+			uint8  thread;			// threads are numbered in order of their first call
+			uint8  align_shift;		// alignment is 1 << align_shift
+			uint8  reserved;
+		};
+
+		struct FileHeader
+		{
+			uint32 magic;
+			uint32 version;
+			uint32 event_count;
+			uint32 allocation_count;
+		};
+
+	public:
+		/* event_alloc stores the trace, it should not be the traced allocator */
+		TraceAllocator(memory::Allocator* parent, memory::Allocator* event_alloc);
+		~TraceAllocator();
+	public:
+		ARC_NO_COPY(TraceAllocator);
+	public:
+		void* allocate(uint64 size, uint32 align = 4) override;
+		void  free(void* data) override;
+	public:
+		const Array<Event>& events() const;
+		uint32 allocation_count() const;
+		/* Drops the events recorded so far and restarts the numbering at 0. Blocks that are
+		 * still live are recorded again as fresh allocations, so their later frees stay valid. */
+		void clear();
+	public:
+		bool save(io::BinaryWriteStream& out);
+		/* Fails on a bad header, a short read or an event that doesn't fit the header, e.g. an
+		 * allocation number >= allocation_count. */
+		static bool load(io::BinaryReadStream& in, Array<Event>& o_events, uint32& o_allocation_count);
+	public:
+		static const uint32 MAGIC = 0x43525441;	// "ATRC"
+		static const uint32 VERSION = 1;
+	private:
+		memory::Allocator* m_parent_alloc = nullptr;
+		std::mutex     m_mutex;
+		Array<Event>   m_events;
+		HashMap<uint64, Event> m_live_blocks;	// address -> event of its allocation
+		uint32         m_next_id = 0;
+	};
+
+}}
@@ -0,0 +1,232 @@
+#include "TrackingAllocator.hpp"
+
+#include "arc/memory/util.hpp"
+#include "arc/logging/log.hpp"
+
+namespace arc { namespace memory {
+
+	namespace
+	{
+		// tag selected by the innermost TagScope of this thread
+		ARC_THREAD_LOCAL const TrackingAllocator* t_tag_owner;
+		ARC_THREAD_LOCAL uint32 t_tag;
+
+		inline uint32 histogram_bucket(uint64 size)
+		{
+			uint32 bucket = 0;
+			while (bucket < TrackingAllocator::HISTOGRAM_BUCKETS - 1 && ((uint64)1 << bucket) < size) bucket++;
+			return bucket;
+		}
+	}
+
+	TrackingAllocator::TagScope::TagScope(TrackingAllocator& alloc, uint32 tag)
+		: m_prev_owner(t_tag_owner)
+		, m_prev_tag(t_tag)
+	{
+		ARC_ASSERT(tag < alloc.tag_count(), "TrackingAllocator: unknown tag");
+		t_tag_owner = &alloc;
+		t_tag = tag;
+	}
+
+	TrackingAllocator::TagScope::~TagScope()
+	{
+		t_tag_owner = m_prev_owner;
+		t_tag = m_prev_tag;
+	}
+
+	TrackingAllocator::TrackingAllocator(memory::Allocator* parent, const char* name)
+		: m_parent_alloc(parent)
+	{
+		auto init = [](Counters& c, const char* n)
+		{
+			c.current = 0;
+			c.peak = 0;
+			c.allocs = 0;
+			c.frees = 0;
+			c.failed = 0;
+			c.over_budget = false;
+			c.budget = 0;
+			c.policy = BudgetPolicy::WARN;
+			c.name = n;
+		};
+
+		init(m_total, name);
+		for (auto& tag : m_tags) init(tag, nullptr);
+		m_tags[UNTAGGED].name = "untagged";
+
+		for (auto& bucket : m_histogram) bucket = 0;
+	}
+
+	TrackingAllocator::~TrackingAllocator()
+	{
+		if (m_total.current.load() != 0)
+		{
+			LOG_WARNING(m_total.name, ": ", m_total.current.load(), " bytes still allocated at destruction");
+		}
+		m_parent_alloc = nullptr;
+	}
+
+	void* TrackingAllocator::allocate(uint64 size, uint32 align)
+	{
+		uint32 tag = t_tag_owner == this ? t_tag : UNTAGGED;
+		auto& tag_counters = m_tags[tag];
+
+		if (!acquire(tag_counters, size)) return nullptr;
+		if (!acquire(m_total, size))
+		{
+			release(tag_counters, size);
+			return nullptr;
+		}
+
+		// header in front of the aligned pointer, the parent might not honour the alignment
+		auto raw = (char*)m_parent_alloc->allocate(size + sizeof(Header) + align, alignof(Header));
+		if (raw == nullptr)
+		{
+			release(tag_counters, size);
+			release(m_total, size);
+			return nullptr;
+		}
+
+		auto data = (char*)util::forward_align_ptr(raw + sizeof(Header), align);
+		auto header = (Header*)(data - sizeof(Header));
+		header->size = size;
+		header->tag = tag;
+		header->offset = (uint32)(data - raw);
+
+		tag_counters.allocs.fetch_add(1, std::memory_order_relaxed);
+		m_total.allocs.fetch_add(1, std::memory_order_relaxed);
+		m_histogram[histogram_bucket(size)].fetch_add(1, std::memory_order_relaxed);
+
+		return data;
+	}
+
+	void TrackingAllocator::free(void* data)
+	{
+		if (data == nullptr) return;
+
+		auto header = *(Header*)((char*)data - sizeof(Header));
+
+		release(m_tags[header.tag], header.size);
+		release(m_total, header.size);
+		m_tags[header.tag].frees.fetch_add(1, std::memory_order_relaxed);
+		m_total.frees.fetch_add(1, std::memory_order_relaxed);
+
+		m_parent_alloc->free((char*)data - header.offset);
+	}
+
+	void TrackingAllocator::set_budget(uint64 bytes, BudgetPolicy policy)
+	{
+		m_total.budget = bytes;
+		m_total.policy = policy;
+	}
+
+	uint32 TrackingAllocator::register_tag(const char* name, uint64 budget, BudgetPolicy policy)
+	{
+		if (m_tag_count == MAX_TAGS)
+		{
+			LOG_ERROR(m_total.name, ": no free tag left for ", name);
+			return INVALID_TAG;
+		}
+
+		auto& tag = m_tags[m_tag_count];
+		tag.name = name;
+		tag.budget = budget;
+		tag.policy = policy;
+		return m_tag_count++;
+	}
+
+	TrackingAllocator::Stats TrackingAllocator::stats() const
+	{
+		return to_stats(m_total);
+	}
+
+	TrackingAllocator::Stats TrackingAllocator::tag_stats(uint32 tag) const
+	{
+		ARC_ASSERT(tag < m_tag_count, "TrackingAllocator: unknown tag");
+		return to_stats(m_tags[tag]);
+	}
+
+	const char* TrackingAllocator::tag_name(uint32 tag) const
+	{
+		return tag < m_tag_count ? m_tags[tag].name : nullptr;
+	}
+
+	uint32 TrackingAllocator::tag_count() const
+	{
+		return m_tag_count;
+	}
+
+	uint64 TrackingAllocator::histogram(uint32 bucket) const
+	{
+		return bucket < HISTOGRAM_BUCKETS ? m_histogram[bucket].load(std::memory_order_relaxed) : 0;
+	}
+
+	void TrackingAllocator::log_report() const
+	{
+		auto s = stats();
+		LOG_INFO(m_total.name, ": ", s.current_bytes, " bytes (peak ", s.peak_bytes, "), ",
+			s.allocation_count, " allocations, ", s.free_count, " frees, ", s.failed_count, " failed");
+
+		for (uint32 i = 0; i < m_tag_count; i++)
+		{
+			auto ts = tag_stats(i);
+			if (ts.allocation_count == 0 && ts.failed_count == 0) continue;
+			LOG_INFO("  ", m_tags[i].name, ": ", ts.current_bytes, " bytes (peak ", ts.peak_bytes, "), ",
+				ts.allocation_count, " allocations, ", ts.free_count, " frees, ", ts.failed_count, " failed");
+		}
+
+		for (uint32 i = 0; i < HISTOGRAM_BUCKETS; i++)
+		{
+			uint64 count = histogram(i);
+			if (count != 0) LOG_INFO("  <= ", (uint64)1 << i, " bytes: ", count);
+		}
+	}
+
+	bool TrackingAllocator::acquire(Counters& counters, uint64 size)
+	{
+		uint64 current = counters.current.fetch_add(size, std::memory_order_relaxed) + size;
+
+		if (counters.budget != 0 && current > counters.budget)
+		{
+			// only report the first allocation over budget until usage drops below it again
+			bool report = !counters.over_budget.exchange(true, std::memory_order_relaxed);
+
+			if (counters.policy == BudgetPolicy::FAIL)
+			{
+				counters.current.fetch_sub(size, std::memory_order_relaxed);
+				counters.failed.fetch_add(1, std::memory_order_relaxed);
+				if (report) LOG_ERROR(m_total.name, ": allocation of ", size, " bytes refused, ", counters.name, " is over its budget of ", counters.budget, " bytes");
+				return false;
+			}
+
+			if (report) LOG_WARNING(m_total.name, ": ", counters.name, " exceeded its budget of ", counters.budget, " bytes (", current, " bytes)");
+		}
+
+		uint64 peak = counters.peak.load(std::memory_order_relaxed);
+		while (current > peak && !counters.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+
+		return true;
+	}
+
+	void TrackingAllocator::release(Counters& counters, uint64 size)
+	{
+		uint64 current = counters.current.fetch_sub(size, std::memory_order_relaxed) - size;
+
+		if (counters.budget != 0 && current <= counters.budget && counters.over_budget.load(std::memory_order_relaxed))
+		{
+			counters.over_budget.store(false, std::memory_order_relaxed);
+		}
+	}
+
+	TrackingAllocator::Stats TrackingAllocator::to_stats(const Counters& counters)
+	{
+		Stats s;
+		s.current_bytes = counters.current.load(std::memory_order_relaxed);
+		s.peak_bytes = counters.peak.load(std::memory_order_relaxed);
+		s.allocation_count = counters.allocs.load(std::memory_order_relaxed);
+		s.free_count = counters.frees.load(std::memory_order_relaxed);
+		s.failed_count = counters.failed.load(std::memory_order_relaxed);
+		return s;
+	}
+
+}}
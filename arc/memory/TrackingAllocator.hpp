@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+
+#include "arc/core.hpp"
+#include "Allocator.hpp"
+
+namespace arc { namespace memory {
+
+	/* Decorator that records statistics about the allocations going through it.
+	 *
+	 * Tracks current and peak bytes, allocation counts and a power-of-two size histogram,
+	 * in total and per tag. The tag of an allocation is chosen with a TagScope on the
+	 * allocating thread. Budgets can be set for the total and for every tag, exceeding
+	 * one either logs a warning or lets the allocation fail.
+	 *
+	 * Every allocation carries a small header, so memory must be freed through the same
+	 * TrackingAllocator. All counters are atomic, the allocator can be shared by threads. */
+	class TrackingAllocator final : public Allocator
+	{
+	public:
+		enum class BudgetPolicy : uint8
+		{
+			WARN = 0,
+			FAIL = 1,
+		};
+
+		struct Stats
+		{
+			uint64 current_bytes;
+			uint64 peak_bytes;
+			uint64 allocation_count;		// successful allocations since construction
+			uint64 free_count;
+			uint64 failed_count;			// allocations refused because of a budget
+		};
+
+		/* Attributes allocations made by the current thread through the given allocator
+		 * to a tag while in scope. Scopes can be nested. */
+		class TagScope
+		{
+		public:
+			TagScope(TrackingAllocator& alloc, uint32 tag);
+			~TagScope();
+		public:
+			ARC_NO_COPY(TagScope);
+		private:
+			const TrackingAllocator* m_prev_owner;
+			uint32 m_prev_tag;
+		};
+
+	public:
+		TrackingAllocator(memory::Allocator* parent, const char* name = "tracking");
+		~TrackingAllocator();
+	public:
+		ARC_NO_COPY(TrackingAllocator);
+	public:
+		void* allocate(uint64 size, uint32 align = 4) override;
+		void  free(void* data) override;
+	public:
+		/* A budget of 0 disables the check. */
+		void set_budget(uint64 bytes, BudgetPolicy policy = BudgetPolicy::WARN);
+
+		/* Returns INVALID_TAG if all tags are in use. Not thread safe, register tags
+		 * before the allocator is shared. */
+		uint32 register_tag(const char* name, uint64 budget = 0, BudgetPolicy policy = BudgetPolicy::WARN);
+	public:
+		Stats stats() const;
+		Stats tag_stats(uint32 tag) const;
+		const char* tag_name(uint32 tag) const;
+		uint32 tag_count() const;
+
+		/* Number of allocations with a size in (2^(bucket-1), 2^bucket]. */
+		uint64 histogram(uint32 bucket) const;
+
+		void log_report() const;
+	public:
+		static const uint32 MAX_TAGS = 16;
+		static const uint32 HISTOGRAM_BUCKETS = 32;
+		static const uint32 UNTAGGED = 0;
+		static const uint32 INVALID_TAG = (uint32)-1;
+	private:
+		struct Header
+		{
+			uint64 size;
+			uint32 tag;
+			uint32 offset;				// distance to the pointer returned by the parent
+		};
+
+		struct Counters
+		{
+			std::atomic<uint64> current;
+			std::atomic<uint64> peak;
+			std::atomic<uint64> allocs;
+			std::atomic<uint64> frees;
+			std::atomic<uint64> failed;
+			std::atomic<bool>   over_budget;
+			uint64       budget;
+			BudgetPolicy policy;
+			const char*  name;
+		};
+	private:
+		bool acquire(Counters& counters, uint64 size);
+		void release(Counters& counters, uint64 size);
+		static Stats to_stats(const Counters& counters);
+	private:
+		memory::Allocator* m_parent_alloc = nullptr;
+
+		Counters m_total;
+		Counters m_tags[MAX_TAGS];
+		uint32   m_tag_count = 1;
+		std::atomic<uint64> m_histogram[HISTOGRAM_BUCKETS];
+	};
+
+}}
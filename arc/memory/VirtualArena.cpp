@@ -0,0 +1,199 @@
+#include "VirtualArena.hpp"
+
+#include "arc/memory/util.hpp"
+#include "arc/memory/no_alloc.hpp"
+#include "arc/logging/log.hpp"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace arc { namespace memory {
+
+	namespace
+	{
+		inline uint64 round_to(uint64 value, uint64 granularity)
+		{
+			return (value + granularity - 1) / granularity * granularity;
+		}
+
+		char* os_reserve(uint64 size)
+		{
+		#ifdef _WIN32
+			return (char*)VirtualAlloc(nullptr, (SIZE_T)size, MEM_RESERVE, PAGE_NOACCESS);
+		#else
+			void* ptr = mmap(nullptr, (size_t)size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+			return ptr == MAP_FAILED ? nullptr : (char*)ptr;
+		#endif
+		}
+
+		void os_release(char* base, uint64 size)
+		{
+		#ifdef _WIN32
+			VirtualFree(base, 0, MEM_RELEASE);
+		#else
+			munmap(base, (size_t)size);
+		#endif
+		}
+
+		bool os_commit(char* begin, uint64 size)
+		{
+		#ifdef _WIN32
+			return VirtualAlloc(begin, (SIZE_T)size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+		#else
+			return mprotect(begin, (size_t)size, PROT_READ | PROT_WRITE) == 0;
+		#endif
+		}
+
+		void os_decommit(char* begin, uint64 size)
+		{
+		#ifdef _WIN32
+			VirtualFree(begin, (SIZE_T)size, MEM_DECOMMIT);
+		#else
+			// drop the pages and make the range inaccessible again
+			madvise(begin, (size_t)size, MADV_DONTNEED);
+			mprotect(begin, (size_t)size, PROT_NONE);
+		#endif
+		}
+	}
+
+	VirtualArena::VirtualArena(uint64 reserve_size)
+	{
+		reserve(reserve_size);
+	}
+
+	VirtualArena::~VirtualArena()
+	{
+		release();
+	}
+
+	VirtualArena::VirtualArena(VirtualArena&& other)
+	{
+		*this = std::move(other);
+	}
+
+	VirtualArena& VirtualArena::operator=(VirtualArena&& other)
+	{
+		if (this == &other) return *this;
+
+		release();
+		m_base = other.m_base;
+		m_reserved = other.m_reserved;
+		m_committed = other.m_committed;
+		m_used = other.m_used;
+
+		other.m_base = nullptr;
+		other.m_reserved = other.m_committed = other.m_used = 0;
+		return *this;
+	}
+
+	void* VirtualArena::allocate(uint64 size, uint32 align)
+	{
+		no_alloc::check(size);
+
+		uint64 begin = util::forward_align(m_used, (uint64)align);
+		uint64 end = begin + size;
+
+		if (end > m_committed && !commit(end)) return nullptr;
+
+		m_used = end;
+		return m_base + begin;
+	}
+
+	void VirtualArena::free(void* data)
+	{}
+
+	bool VirtualArena::try_expand_in_place(void* data, uint64 old_size, uint64 new_size)
+	{
+		// only the most recent allocation can change its size
+		uint64 begin = (char*)data - m_base;
+		if (data == nullptr || begin + old_size != m_used) return false;
+		if (begin + new_size > m_committed && !commit(begin + new_size)) return false;
+
+		if (new_size > old_size) no_alloc::check(new_size - old_size);
+		m_used = begin + new_size;
+		return true;
+	}
+
+	bool VirtualArena::reserve(uint64 size)
+	{
+		release();
+
+		size = round_to(size, page_size());
+		m_base = os_reserve(size);
+		if (m_base == nullptr)
+		{
+			LOG_ERROR("VirtualArena: could not reserve ", size, " bytes of address space");
+			return false;
+		}
+
+		m_reserved = size;
+		return true;
+	}
+
+	void VirtualArena::release()
+	{
+		if (m_base == nullptr) return;
+
+		os_release(m_base, m_reserved);
+		m_base = nullptr;
+		m_reserved = m_committed = m_used = 0;
+	}
+
+	bool VirtualArena::commit(uint64 size)
+	{
+		if (size <= m_committed) return true;
+		if (size > m_reserved) return false;
+
+		// commit in larger steps to keep the number of system calls down
+		uint64 new_committed = round_to(size, COMMIT_GRANULARITY);
+		if (new_committed < m_committed + m_committed / 2) new_committed = round_to(m_committed + m_committed / 2, COMMIT_GRANULARITY);
+		if (new_committed > m_reserved) new_committed = m_reserved;
+
+		if (!os_commit(m_base + m_committed, new_committed - m_committed))
+		{
+			LOG_ERROR("VirtualArena: could not commit ", new_committed, " bytes");
+			return false;
+		}
+
+		m_committed = new_committed;
+		return true;
+	}
+
+	void VirtualArena::decommit(uint64 size)
+	{
+		size = round_to(size, page_size());
+		if (size >= m_committed) return;
+
+		os_decommit(m_base + size, m_committed - size);
+		m_committed = size;
+		if (m_used > m_committed) m_used = m_committed;
+	}
+
+	void VirtualArena::reset()
+	{
+		m_used = 0;
+	}
+
+	uint64 VirtualArena::page_size()
+	{
+		static uint64 size = 0;
+		if (size == 0)
+		{
+		#ifdef _WIN32
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+			size = info.dwPageSize;
+		#else
+			size = (uint64)sysconf(_SC_PAGESIZE);
+		#endif
+		}
+		return size;
+	}
+
+}}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "arc/core.hpp"
+#include "Allocator.hpp"
+
+namespace arc { namespace memory {
+
+	/* Address range that is reserved up front and backed by physical memory on demand.
+	 *
+	 * reserve() claims the address space without committing it, commit() makes the first
+	 * bytes of the range usable. Memory inside the range never moves, so pointers stay valid
+	 * while the arena grows. As an Allocator it is a bump allocator that commits pages as
+	 * it goes, free() is a no-op and reset() starts over. */
+	class VirtualArena final : public Allocator
+	{
+	public:
+		VirtualArena() = default;
+		VirtualArena(uint64 reserve_size);
+		~VirtualArena();
+	public: // move constructor and assignment
+		VirtualArena(VirtualArena&& other);
+		VirtualArena& operator=(VirtualArena&& other);
+	public:
+		ARC_NO_COPY(VirtualArena);
+	public:
+		void* allocate(uint64 size, uint32 align = 4) override;
+		void  free(void* data) override;
+		bool  try_expand_in_place(void* data, uint64 old_size, uint64 new_size) override;
+	public:
+		/* Reserves the address range, rounded up to the page size. Releases a range
+		 * reserved before. */
+		bool reserve(uint64 size);
+		void release();
+
+		/* Makes sure the first size bytes of the range are committed. Returns false if the
+		 * range is too small or the system is out of memory. */
+		bool commit(uint64 size);
+
+		/* Returns committed pages beyond the first size bytes to the system. */
+		void decommit(uint64 size);
+
+		/* Rewinds the bump pointer, committed pages are kept. */
+		void reset();
+	public:
+		inline char*  data() const { return m_base; }
+		inline uint64 used() const { return m_used; }
+		inline uint64 committed() const { return m_committed; }
+		inline uint64 reserved() const { return m_reserved; }
+		inline bool   is_reserved() const { return m_base != nullptr; }
+	public:
+		static uint64 page_size();
+		static const uint64 COMMIT_GRANULARITY = 64 * 1024;	// minimum amount committed at once
+	private:
+		char*  m_base = nullptr;
+		uint64 m_reserved = 0;
+		uint64 m_committed = 0;
+		uint64 m_used = 0;
+	};
+
+}}
@@ -0,0 +1,76 @@
+#include "no_alloc.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace arc { namespace memory { namespace no_alloc {
+
+	ARC_THREAD_LOCAL scope* _t_current_scope = nullptr;
+	ARC_THREAD_LOCAL uint32 _t_allow_depth = 0;
+
+	namespace
+	{
+		std::atomic<uint64>      g_violation_count(0);
+		std::atomic<const char*> g_last_violation(nullptr);
+	}
+
+	void report(uint64 size)
+	{
+		auto s = _t_current_scope;
+		s->_violations += 1;
+		g_violation_count.fetch_add(1, std::memory_order_relaxed);
+		g_last_violation.store(s->_name, std::memory_order_relaxed);
+
+#ifdef ARC_NO_ALLOC_ASSERT
+		// the assert handler may allocate itself
+		_t_allow_depth += 1;
+		ARC_ASSERT(false, "allocation of %llu bytes inside no-alloc region '%s'", (unsigned long long)size, s->_name);
+		_t_allow_depth -= 1;
+#endif
+	}
+
+	uint64 violation_count()
+	{
+		return g_violation_count.load(std::memory_order_relaxed);
+	}
+
+	void reset_violation_count()
+	{
+		g_violation_count.store(0, std::memory_order_relaxed);
+		g_last_violation.store(nullptr, std::memory_order_relaxed);
+	}
+
+	const char* last_violation()
+	{
+		return g_last_violation.load(std::memory_order_relaxed);
+	}
+
+}}}
+
+#ifdef ARC_NO_ALLOC_HOOK_OPERATOR_NEW
+
+	void* operator new(std::size_t size)
+	{
+		arc::memory::no_alloc::check(size);
+		void* ptr = std::malloc(size == 0 ? 1 : size);
+		if (ptr == nullptr) throw std::bad_alloc();
+		return ptr;
+	}
+
+	void* operator new[](std::size_t size)
+	{
+		return operator new(size);
+	}
+
+	void operator delete(void* ptr) noexcept
+	{
+		std::free(ptr);
+	}
+
+	void operator delete[](void* ptr) noexcept
+	{
+		std::free(ptr);
+	}
+
+#endif
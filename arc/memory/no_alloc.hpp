@@ -0,0 +1,70 @@
+#pragma once
+
+#include "arc/core.hpp"
+
+// allocations inside a no-alloc region raise an assert in debug builds, release builds only count them
+#ifdef _DEBUG
+	#define ARC_NO_ALLOC_ASSERT
+#endif
+
+// define ARC_NO_ALLOC_HOOK_OPERATOR_NEW to also check the global operator new
+
+namespace arc { namespace memory { namespace no_alloc {
+
+	/* Marks the calling thread as being inside a region that must not allocate.
+	 *
+	 * Every allocator calls check() when it hands out or grows memory; decorators that
+	 * forward every call leave it to their parent. An allocator that refills from its parent
+	 * is reported twice. Regions nest, a violation is attributed to the innermost one. */
+	struct scope;
+	struct allow_scope;
+
+	extern ARC_THREAD_LOCAL scope* _t_current_scope;
+	extern ARC_THREAD_LOCAL uint32 _t_allow_depth;
+
+	struct scope
+	{
+		inline scope(const char* name) : _name(name), _violations(0)
+		{
+			_prev = _t_current_scope;
+			_t_current_scope = this;
+		}
+
+		inline ~scope()
+		{
+			_t_current_scope = _prev;
+		}
+
+		scope*        _prev;
+		const char*   _name;
+		uint32        _violations;
+	};
+
+	/* Lifts the restriction of the enclosing regions, e.g. for a deliberate slow path. */
+	struct allow_scope
+	{
+		inline allow_scope()  { _t_allow_depth += 1; }
+		inline ~allow_scope() { _t_allow_depth -= 1; }
+	};
+
+	void report(uint64 size);
+
+	inline void check(uint64 size)
+	{
+		if (_t_current_scope != nullptr && _t_allow_depth == 0) report(size);
+	}
+
+	/* Violations of all threads since start or the last reset. */
+	uint64 violation_count();
+	void   reset_violation_count();
+
+	/* Name of the region the most recent violation happened in, nullptr if there was none. */
+	const char* last_violation();
+
+}}}
+
+#define ARC_NO_ALLOC_SCOPE(name) \
+	arc::memory::no_alloc::scope __arc_no_alloc_scope(name);
+
+#define ARC_ALLOW_ALLOC_SCOPE \
+	const arc::memory::no_alloc::allow_scope __arc_allow_alloc_scope;
@@ -0,0 +1,48 @@
+#include "scratch.hpp"
+
+namespace arc { namespace memory {
+
+	namespace
+	{
+		Mallocator g_scratch_parent;
+
+		// ARC_THREAD_LOCAL only supports plain data on every platform
+		ARC_THREAD_LOCAL LinearAllocator* t_scratch;
+		ARC_THREAD_LOCAL uint32 t_scope_depth;
+	}
+
+	LinearAllocator& scratch()
+	{
+		if (t_scratch == nullptr)
+		{
+			t_scratch = g_scratch_parent.create<LinearAllocator>(&g_scratch_parent, SCRATCH_BLOCK_SIZE);
+		}
+		return *t_scratch;
+	}
+
+	void release_scratch()
+	{
+		ARC_ASSERT(t_scope_depth == 0, "release_scratch() called inside a ScratchScope");
+		if (t_scratch == nullptr) return;
+
+		g_scratch_parent.destroy(t_scratch);
+		t_scratch = nullptr;
+	}
+
+	ScratchScope::ScratchScope()
+		: m_alloc(scratch())
+		, m_marker(m_alloc.get_marker())
+	{
+		t_scope_depth += 1;
+	}
+
+	ScratchScope::~ScratchScope()
+	{
+		t_scope_depth -= 1;
+		m_alloc.rewind(m_marker);
+
+		// merge overflow blocks once the arena is empty again
+		if (t_scope_depth == 0 && m_alloc.used() == 0) m_alloc.reset();
+	}
+
+}}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "arc/core.hpp"
+#include "LinearAllocator.hpp"
+
+namespace arc { namespace memory {
+
+	/* Thread-local arena for temporary memory.
+	 *
+	 * Every thread gets its own LinearAllocator on first use. Allocations are released when
+	 * the enclosing ScratchScope ends. Scopes nest; when the outermost one leaves the arena
+	 * empty, it is reset, which merges overflow blocks into a single block for the next use. */
+	LinearAllocator& scratch();
+
+	/* Frees the scratch arena of the calling thread. Call it before a thread that used
+	 * scratch() exits. */
+	void release_scratch();
+
+	static const uint32 SCRATCH_BLOCK_SIZE = 64 * 1024;		// initial size, grows on demand
+
+	/* Rewinds the scratch arena of the calling thread when going out of scope.
+	 * Destructors of objects created within the scope are not called. */
+	class ScratchScope
+	{
+	public:
+		ScratchScope();
+		~ScratchScope();
+	public:
+		ARC_NO_COPY(ScratchScope);
+	public:
+		inline LinearAllocator& allocator() { return m_alloc; }
+	private:
+		LinearAllocator& m_alloc;
+		LinearAllocator::Marker m_marker;
+	};
+
+}}
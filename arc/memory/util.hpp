@@ -4,8 +4,16 @@
 #include <type_traits>		 // std::is_trivial 
 #include <cstring>           // std::memcpy
 
+#include "arc/core/type_traits.hpp"
+
+#if defined(_M_X64) || defined(_M_IX86)
+	#include <xmmintrin.h>	 // _mm_prefetch
+#endif
+
 namespace arc { namespace memory { namespace util 
 {
+    /// data written by different threads is kept this far apart to avoid false sharing
+    static const uint32 CACHE_LINE_SIZE = 64;
 
     template<typename T> inline
     void move_elements(void* from, void* to, uint32 n)
@@ -44,6 +52,27 @@ namespace arc { namespace memory { namespace util
         }
     }
 
+    /// moves n elements to uninitialized memory and destroys the originals
+    template<typename T> inline
+    void relocate_elements(void* from, void* to, uint32 n)
+    {
+        if (is_trivially_relocatable<T>::value)
+        {
+            std::memcpy(to, from, n*sizeof(T));
+        }
+        else
+        {
+            auto fromT = static_cast<T*>(from);
+            auto toT = static_cast<T*>(to);
+            for (uint32 i=0; i<n; i++)
+            {
+                // in place constructor
+                new (&toT[i]) T(std::move(fromT[i]));
+                fromT[i].~T();
+            }
+        }
+    }
+
     template<typename T> inline
     void copy_elements(void* from, void* to, uint32 n)
     {
@@ -134,4 +163,16 @@ namespace arc { namespace memory { namespace util
 		std::memcpy(to, from, byte_count);
 	}
 
+	/// hints the cpu to load the cache line holding ptr, for reading
+	inline void prefetch(const void* ptr)
+	{
+#if defined(_M_X64) || defined(_M_IX86)
+		_mm_prefetch((const char*)ptr, _MM_HINT_T0);
+#elif defined(__GNUC__)
+		__builtin_prefetch(ptr);
+#else
+		(void)ptr;
+#endif
+	}
+
 }}} // namespace arc::memory::util
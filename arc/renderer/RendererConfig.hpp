@@ -7,7 +7,9 @@ namespace arc { namespace renderer {
 	struct Config
 	{
 		uint32 geometry_buffer_static_size = 64 * 1024 * 1024; // 64MB
-		uint32 frame_allocator_size = 4 * 1024 * 1024;		   // 4MB
+		uint32 frame_allocator_size = 4 * 1024 * 1024;		   // 4MB, initial size, grows on demand
+		uint32 frame_allocator_count = 2;					   // frames that can be in flight at the same time
+		uint32 max_submitted_buckets = 16;					   // per frame, reserved up front since submitting must not allocate, more are dropped
 	};
 
 	struct AllocatorConfig
@@ -1,8 +1,14 @@
 #include "Renderer_GL44.hpp"
 
 #include "arc/collections/Array.inl"
+#include "arc/collections/ChunkedArray.inl"
+#include "arc/collections/ConcurrentHashMap.inl"
+#include "arc/collections/SmallArray.inl"
+#include "arc/collections/StaticPerfectMap.inl"
+#include "arc/collections/VirtualArray.inl"
 #include "arc/gl/functions.hpp"
 #include "arc/logging/log.hpp"
+#include "arc/memory/no_alloc.hpp"
 
 #include <algorithm>
 
@@ -60,13 +66,17 @@ namespace arc { namespace renderer {
 
 	Renderer_GL44::Renderer_GL44(const Config& config, const AllocatorConfig& allocator_config)
 		: m_alloc(allocator_config.longterm_allocator)
-		, m_frame_alloc(allocator_config.longterm_allocator, config.frame_allocator_size)
+		, m_frame_alloc(allocator_config.longterm_allocator, config.frame_allocator_size, config.frame_allocator_count)
 		, m_submitted_render_buckets(*m_alloc)
 		, m_geometry_config_data(m_alloc, 16, 16, 128)
 		, m_vertex_layouts(*m_alloc)
 		, m_texture_backend(config,allocator_config)
 	{
 		initialize(config,allocator_config);
+
+		// submitting must not allocate, see render_bucket_submit
+		m_max_submitted_buckets = config.max_submitted_buckets;
+		m_submitted_render_buckets.reserve(m_max_submitted_buckets);
 	}
 
 	Renderer_GL44::~Renderer_GL44()
@@ -126,25 +136,28 @@ namespace arc { namespace renderer {
 
 		// geometry ///////////////////////////////////////////
 		{
-			uint32 last_id_before_increment = 128;
-			uint32 id_size_increment = 128;
+			uint32 initial_geometry_count = 128;
+			uint32 geometry_count_increment = 128;
+			// the data store reserves address space for every id up front, 52 bytes each,
+			// 32 bit builds can't spare the 2GB that 40M ids would take
+			uint32 max_geometry_count = sizeof(void*) == 8 ? 40000000 : 1000000;
 
 			// init index pool
 			m_geometry_indices.initialize(
 				allocator_config.longterm_allocator,
-				last_id_before_increment,
-				id_size_increment,
-				40000000,
-				[this](uint32 new_last_id) {
-					GeometryData gd; gd.block_size = 0;
-					m_geometry_data.resize(new_last_id+1, gd);
-				}
+				initial_geometry_count,
+				max_geometry_count,
+				handle_pool::LinearGrowth(geometry_count_increment)
 			);
 
 			// init data store
-			m_geometry_data.initialize(allocator_config.longterm_allocator, 0);
+			if (!m_geometry_data.initialize(max_geometry_count + 1, 0))
+			{
+				LOG_ERROR("Could not reserve address space for ", max_geometry_count, " geometries.");
+				return false;
+			}
 			GeometryData gd; gd.block_size = 0;
-			m_geometry_data.resize(1 + last_id_before_increment, gd);
+			m_geometry_data.resize(1 + initial_geometry_count, gd);
 		}
 
 		// geometry config //////////////////////////////////////
@@ -250,7 +263,7 @@ namespace arc { namespace renderer {
 
 			GeometryConfig* gc;
 			tie(idx,gc) = m_geometry_config_data.create();
-			gc->gl_vao = m_vao_gl_ids[idx];
+			gc->gl_vao = m_vao_gl_ids[GeometryConfigID(idx).index()];
 			gc->index_type = index_type;
 			gc->layout = vl_ptr;
 			gc->primitive = primitive_type;
@@ -265,7 +278,7 @@ namespace arc { namespace renderer {
 			{
 				GeometryConfig* gc;
 				tie(idx, gc) = m_geometry_config_data.create();
-				gc->gl_vao = m_vao_gl_ids[idx];
+				gc->gl_vao = m_vao_gl_ids[GeometryConfigID(idx).index()];
 				gc->index_type = index_type;
 				gc->layout = vl_ptr;
 				gc->primitive = primitive_type;
@@ -302,8 +315,14 @@ namespace arc { namespace renderer {
 		uint32 block_end = aligned_begin + vertex_size + index_size;
 		if (block_end > buffer.size) return INVALID_GEOMETRY_ID; // not enough memory
 
-		uint32 index = m_geometry_indices.create();
-		auto& mesh = m_geometry_data[index];
+		GeometryID id(m_geometry_indices.create());
+		if (id == INVALID_GEOMETRY_ID) return INVALID_GEOMETRY_ID;
+		if (m_geometry_data.size() <= m_geometry_indices.capacity())
+		{
+			GeometryData gd; gd.block_size = 0;
+			m_geometry_data.resize(m_geometry_indices.capacity() + 1, gd);
+		}
+		auto& mesh = m_geometry_data[id.index()];
 
 		mesh.buffer_type = buffer_type;
 
@@ -325,22 +344,24 @@ namespace arc { namespace renderer {
 
 		buffer.front = block_end;
 
-		return GeometryID{ index };
+		return id;
 	}
 
 	void Renderer_GL44::geometry_destroy(GeometryID id)
 	{
 		// TODO manage free memory
+		ARC_ASSERT(m_geometry_indices.valid(id.value()), "Invalid GeometryID");
 
-		auto& mesh = m_geometry_data[id.value()];
+		auto& mesh = m_geometry_data[id.index()];
 		mesh.index_count = mesh.index_size = mesh.vertex_count = mesh.vertex_size = 0;
+		m_geometry_indices.release(id.value());
 	}
 
 	UntypedBuffer Renderer_GL44::geometry_map_vertices(GeometryID id)
 	{
 		ARC_ASSERT(m_geometry_indices.valid(id.value()), "Invalid GeometryID");
 
-		auto& mesh = m_geometry_data[id.value()];
+		auto& mesh = m_geometry_data[id.index()];
 
 		auto target = gl::BufferType::Array;
 		gl::bind_buffer(target, mesh.gl_id);
@@ -356,7 +377,7 @@ namespace arc { namespace renderer {
 	{
 		ARC_ASSERT(m_geometry_indices.valid(id.value()), "Invalid GeometryID");
 
-		auto& mesh = m_geometry_data[id.value()];
+		auto& mesh = m_geometry_data[id.index()];
 
 		auto target = gl::BufferType::Array;
 		gl::bind_buffer(target, mesh.gl_id);
@@ -372,7 +393,7 @@ namespace arc { namespace renderer {
 	{
 		ARC_ASSERT(m_geometry_indices.valid(id.value()), "Invalid GeometryID");
 
-		auto& mesh = m_geometry_data[id.value()];
+		auto& mesh = m_geometry_data[id.index()];
 
 		auto target = gl::BufferType::Array;
 		gl::bind_buffer(target, mesh.gl_id);
@@ -383,7 +404,7 @@ namespace arc { namespace renderer {
 	{
 		ARC_ASSERT(m_geometry_indices.valid(id.value()), "Invalid GeometryID");
 
-		auto& mesh = m_geometry_data[id.value()];
+		auto& mesh = m_geometry_data[id.index()];
 
 		auto target = gl::BufferType::Array;
 		gl::bind_buffer(target, mesh.gl_id);
@@ -393,28 +414,28 @@ namespace arc { namespace renderer {
 	GeometryBufferType Renderer_GL44::geometry_get_buffer(GeometryID id)
 	{
 		ARC_ASSERT(m_geometry_indices.valid(id.value()), "Invalid GeometryID");
-		auto& mesh = m_geometry_data[id.value()];
+		auto& mesh = m_geometry_data[id.index()];
 		return mesh.buffer_type;
 	}
 
 	GeometryConfigID Renderer_GL44::geometry_get_config(GeometryID id)
 	{
 		ARC_ASSERT(m_geometry_indices.valid(id.value()), "Invalid GeometryID");
-		auto& mesh = m_geometry_data[id.value()];
+		auto& mesh = m_geometry_data[id.index()];
 		return mesh.geometry_config_id;
 	}
 
 	uint32 Renderer_GL44::geometry_get_index_count(GeometryID id)
 	{
 		ARC_ASSERT(m_geometry_indices.valid(id.value()), "Invalid GeometryID");
-		auto& mesh = m_geometry_data[id.value()];
+		auto& mesh = m_geometry_data[id.index()];
 		return mesh.index_count;
 	}
 
 	uint32 Renderer_GL44::geometry_get_vertex_count(GeometryID id)
 	{
 		ARC_ASSERT(m_geometry_indices.valid(id.value()), "Invalid GeometryID");
-		auto& mesh = m_geometry_data[id.value()];
+		auto& mesh = m_geometry_data[id.index()];
 		return mesh.vertex_count;
 	}
 
@@ -444,8 +465,17 @@ namespace arc { namespace renderer {
 	void Renderer_GL44::render_bucket_submit(RenderBucketBase* bucket)
 	{
 		// TODO: make thread safe
+		ARC_NO_ALLOC_SCOPE("render_bucket_submit");
 		auto b = static_cast<RenderBucket_GL44*>(bucket);
 
+		// growing the list would allocate, the limit is set by Config::max_submitted_buckets
+		if (m_submitted_render_buckets.size() >= m_max_submitted_buckets)
+		{
+			ARC_ASSERT(false, "Too many render buckets submitted in this frame");
+			LOG_ERROR("Dropped render bucket, more than ", m_max_submitted_buckets, " submitted in this frame.");
+			return;
+		}
+
 		// sort commands in this context
 		std::sort(b->m_commands, b->m_commands + b->m_count, [](const RenderCommand_GL44& a, const RenderCommand_GL44& b)
 		{
@@ -463,7 +493,14 @@ namespace arc { namespace renderer {
 	void Renderer_GL44::update_frame_begin()
 	{
 		m_frame_counter.increment();
-		m_frame_alloc.reset();
+
+		// frames are retired by update_frame_end() on this thread, waiting would never end
+		if (!m_frame_alloc.begin_frame(m_frame_counter, false))
+		{
+			LOG_ERROR("Frame memory for frame ", m_frame_counter.value(), " is still in use, update_frame_end() was skipped.");
+			ARC_ASSERT(false, "Frame memory is still in use");
+			ARC_FAIL_GRACEFULLY_MESSAGE("Frame memory is still in use.");
+		}
 		m_submitted_render_buckets.clear();
 	}
 
@@ -473,9 +510,9 @@ namespace arc { namespace renderer {
 		auto cmd_data = static_cast<DefaultCommandData*>(commands->data);
 		auto sk = batch_key.fields;
 
-		auto& gd = m_geometry_data[cmd_data->geometry.value()];
+		auto& gd = m_geometry_data[cmd_data->geometry.index()];
 		auto& gcd = *m_geometry_config_data.data(gd.geometry_config_id.value());
-		auto& sd = m_shader_backend.m_shader_data[sk.material];
+		auto& sd = m_shader_backend.m_shader_data[ShaderID((uint32)sk.material).index()];
 
 		current.index_type = gcd.index_type;
 		current.primitive_type = gcd.primitive;
@@ -517,7 +554,7 @@ namespace arc { namespace renderer {
 			{
 				auto& sh_att = sd.vertex_attributes[i];
 
-				auto vl_att_ptr = gcd.layout->find_attribute(sh_att.name); // TODO: faster?
+				auto vl_att_ptr = gcd.layout->find_attribute(sh_att.name);
 				if (vl_att_ptr == nullptr)
 				{
 					LOG_WARNING("unmapped shader vertex property");
@@ -596,6 +633,15 @@ namespace arc { namespace renderer {
 	}
 
 	void Renderer_GL44::update_frame_end()
+	{
+		ARC_NO_ALLOC_SCOPE("update_frame_end");
+		render_submitted_buckets();
+
+		// all command data of this frame was consumed
+		m_frame_alloc.retire_frame(m_frame_counter);
+	}
+
+	void Renderer_GL44::render_submitted_buckets()
 	{
 		// if there was nothing submitted, do early return
 		if (m_submitted_render_buckets.size() == 0) return;
@@ -636,7 +682,7 @@ namespace arc { namespace renderer {
 			auto& cmd = m_render_command_data[i];
 			auto  key = SortKey_GL44::Decode(cmd.sort_key);
 			auto  dcd = (DefaultCommandData*)m_render_command_data[i].data;
-			auto& g = m_geometry_data[dcd->geometry.value()];
+			auto& g = m_geometry_data[dcd->geometry.index()];
 
 
 			// render commands differ in more than depth
@@ -738,10 +784,11 @@ namespace arc { namespace renderer {
 
 	UntypedBuffer RenderBucket_GL44::add(ShaderID shader, GeometryID geometry, uint16 sort_depth)
 	{
+		ARC_NO_ALLOC_SCOPE("RenderBucket_GL44::add");
 		auto& cmd = m_commands[m_count];
 
-		auto& gd = m_renderer->m_geometry_data[geometry.value()];
-		auto& sd = m_renderer->m_shader_backend.m_shader_data[shader.value()];
+		auto& gd = m_renderer->m_geometry_data[geometry.index()];
+		auto& sd = m_renderer->m_shader_backend.m_shader_data[shader.index()];
 
 		// allocate the data section
 		m_data_current = (char*)memory::util::forward_align_ptr(m_data_current, DRAW_DATA_ALIGNMENT);
@@ -787,7 +834,7 @@ namespace arc { namespace renderer {
 			uint32					buffer;
 		};
 
-		HashMap<uint8> name_to_location;
+		HashMap<StringHash64, uint8> name_to_location;
 
 		Entry entries[16];
 	};
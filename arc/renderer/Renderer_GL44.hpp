@@ -2,7 +2,9 @@
 
 #include "arc/collections/Array.hpp"
 #include "arc/collections/HashMap.hpp"
-#include "arc/memory/LinearAllocator.hpp"
+#include "arc/collections/SmallArray.hpp"
+#include "arc/collections/VirtualArray.hpp"
+#include "arc/memory/FrameAllocator.hpp"
 #include "arc/util/Counter.hpp"
 
 #include "RendererBase.hpp"
@@ -88,7 +90,7 @@ namespace arc { namespace renderer {
 		inline gl44::TextureManager& texture_manager() { return m_texture_backend; }
 	private:
 		memory::Allocator* m_alloc;
-		memory::LinearAllocator m_frame_alloc;
+		memory::FrameAllocator m_frame_alloc;
 	private:
 		gl44::TextureManager m_texture_backend;
 	private:
@@ -123,8 +125,8 @@ namespace arc { namespace renderer {
 			GeometryBufferType buffer_type;
 			uint32 gl_id;
 		};
-		IndexPool32 m_geometry_indices;
-		Array<GeometryData> m_geometry_data;
+		GeometryID::Pool m_geometry_indices;
+		VirtualArray<GeometryData> m_geometry_data;		// address range for all possible ids, never moves
 	private:
 		struct GeometryConfig
 		{
@@ -135,8 +137,8 @@ namespace arc { namespace renderer {
 
 			inline bool operator==(GeometryConfig other) const { return layout == other.layout && primitive == other.primitive && index_type == other.index_type; }
 		};
-		CompactPool<GeometryConfig> m_geometry_config_data;
-		Array<VertexLayout*> m_vertex_layouts;
+		CompactPool<GeometryConfig, GeometryConfigID::Pool> m_geometry_config_data;
+		SmallArray<VertexLayout*, 8> m_vertex_layouts;
 	private:
 		struct VertexLayoutData
 		{
@@ -150,6 +152,7 @@ namespace arc { namespace renderer {
 			GeometryID geometry;
 		};
 		Array<RenderBucket_GL44*> m_submitted_render_buckets;
+		uint32 m_max_submitted_buckets = 0;
 		friend class RenderBucket_GL44;
 	private:
 		Counter32 m_frame_counter;
@@ -167,6 +170,7 @@ namespace arc { namespace renderer {
 			VertexLayout* vertex_layout = nullptr;
 		};
 		uint32 render_state_switch(RenderState& current, RenderCommand_GL44* commands, uint32 max_count);
+		void render_submitted_buckets();
 
 		uint32 m_gl_dib;
 		UntypedBuffer m_gl_dib_data;
@@ -1,8 +1,60 @@
 
 #include "VertexLayout.hpp"
 
+#include "arc/collections/StaticPerfectMap.inl"
+
 namespace arc { namespace renderer {
 
+	VertexLayout::VertexLayout(StringHash32 name_hash, VertexAttribute* attributes, uint8 count, uint8 stride)
+		: m_name_hash(name_hash), m_attributes(attributes), m_count(count), m_stride(stride) 
+	{
+		std::sort(m_attributes, m_attributes + m_count);
+		index_attributes();
+	}
+
+	VertexLayout::VertexLayout(StringHash32 name_hash, uint8 stride, const Slice<VertexAttribute> attributes, memory::Allocator* alloc)
+		: m_name_hash(name_hash), m_count(static_cast<uint8_t>(attributes.size())), m_stride(stride), m_alloc(alloc)
+	{
+		m_attributes = alloc->create_n<VertexAttribute>(m_count);
+		for (uint32_t i = 0; i < m_count; i++) m_attributes[i] = attributes[i];
+		std::sort(m_attributes, m_attributes + m_count);
+		index_attributes();
+	}
+
+	void VertexLayout::index_attributes()
+	{
+		// larger layouts are searched linearly
+		m_attribute_indexed = false;
+		if (m_count > MAX_ATTRIBUTES) return;
+
+		// a name may repeat, the first attribute wins like in the linear search
+		AttributeIndex::Entry entries[MAX_ATTRIBUTES];
+		uint32 entry_count = 0;
+		for (uint8 i = 0; i < m_count; i++)
+		{
+			StringHash32 name = m_attributes[i].hash();
+			bool repeated = false;
+			for (uint32 k = 0; k < entry_count && !repeated; k++) repeated = entries[k].key == name;
+			if (!repeated) entries[entry_count++] = { name, i };
+		}
+		m_attribute_indexed = m_attribute_index.build(Slice<const AttributeIndex::Entry>(entries, entry_count));
+	}
+
+	const VertexAttribute* VertexLayout::find_attribute(StringHash32 name_hash) const
+	{
+		if (m_attribute_indexed)
+		{
+			auto idx = m_attribute_index.lookup(name_hash);
+			return idx ? m_attributes + *idx : nullptr;
+		}
+
+		for (uint32 i = 0; i < m_count; i++)
+		{
+			if (m_attributes[i].hash() == name_hash) return m_attributes + i;
+		}
+		return nullptr;
+	}
+
 	uint32 type_gl(VertexAttribute::Type t)
 	{
 		using T = VertexAttribute::Type;
@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include "arc/common.hpp"
+#include "arc/collections/StaticPerfectMap.hpp"
 #include "arc/hash/StringHash.hpp"
 #include "arc/gl/types.hpp"
 #include "arc/memory/Allocator.hpp"
@@ -66,6 +67,8 @@ namespace arc { namespace renderer {
 
 	struct VertexLayout
 	{
+	public:
+		static const uint32 MAX_ATTRIBUTES = 16;
 	public:
 		inline StringHash32 name_hash() const                    { return m_name_hash; }
 		inline uint8 count() const                               { return m_count; }
@@ -75,30 +78,25 @@ namespace arc { namespace renderer {
 	public:
 		const VertexAttribute* find_attribute(StringHash32 name_hash) const;
 	public:
-		inline VertexLayout(StringHash32 name_hash, VertexAttribute* attributes, uint8 count, uint8 stride)
-			: m_name_hash(name_hash), m_attributes(attributes), m_count(count), m_stride(stride) 
-		{
-			std::sort(m_attributes, m_attributes + m_count);
-		}
-		inline VertexLayout(StringHash32 name_hash, uint8 stride, const Slice<VertexAttribute> attributes, memory::Allocator* alloc)
-			: m_name_hash(name_hash), m_count(static_cast<uint8_t>(attributes.size())), m_stride(stride), m_alloc(alloc)
-		{
-			m_attributes = alloc->create_n<VertexAttribute>(m_count);
-			for (uint32_t i = 0; i < m_count; i++) m_attributes[i] = attributes[i];
-			std::sort(m_attributes, m_attributes + m_count);
-		}
+		VertexLayout(StringHash32 name_hash, VertexAttribute* attributes, uint8 count, uint8 stride);
+		VertexLayout(StringHash32 name_hash, uint8 stride, const Slice<VertexAttribute> attributes, memory::Allocator* alloc);
 		inline ~VertexLayout()
 		{
 			if (m_alloc) m_alloc->destroy_n(m_attributes, m_count);
 		}
 	private:
 		ARC_NO_COPY(VertexLayout);
+		void index_attributes();
 	private:
 		StringHash32 m_name_hash;
 		VertexAttribute* m_attributes = nullptr;
 		uint8 m_count = 0;
 		uint8 m_stride = 0;
 		memory::Allocator* m_alloc = nullptr;
+
+		using AttributeIndex = StaticPerfectMap<StringHash32, uint8, MAX_ATTRIBUTES>;
+		AttributeIndex m_attribute_index;	// name -> position in m_attributes
+		bool m_attribute_indexed = false;	// otherwise find_attribute() scans m_attributes
 	private:
 		friend bool equal(const VertexLayout& a, const VertexLayout& b);
 	};
@@ -107,15 +105,6 @@ namespace arc { namespace renderer {
 
 	bool equal(const VertexLayout& a, const VertexLayout& b);
 
-	inline const VertexAttribute* VertexLayout::find_attribute(StringHash32 name_hash) const
-	{
-		for (uint32 i = 0; i < m_count; i++)
-		{
-			if (m_attributes[i].hash() == name_hash) return m_attributes + i;
-		}
-		return nullptr;
-	}
-
 	gl::IndexType type_gl(IndexType t);
 	uint32 type_gl(VertexAttribute::Type t);
 	bool type_normalize(VertexAttribute::Type t);
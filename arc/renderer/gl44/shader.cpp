@@ -3,8 +3,11 @@
 #include <iostream>
 
 #include "arc/collections/Array.inl"
+#include "arc/collections/SmallArray.inl"
+#include "arc/collections/StaticPerfectMap.inl"
 #include "arc/gl/functions.hpp"
 #include "arc/memory/util.hpp"
+#include "arc/memory/scratch.hpp"
 #include "arc/math/common.hpp"
 #include "arc/logging/log.hpp"
 
@@ -205,7 +208,18 @@ namespace arc { namespace renderer { namespace gl44 {
 
 	ShaderID ShaderBackend::create_shader(StringView lua_file_path)
 	{
-		uint32 idx = m_shader_indices.create();
+		ShaderID id(m_shader_indices.create());
+		if (id == INVALID_SHADER_ID)
+		{
+			LOG_ERROR("Too many shaders");
+			return INVALID_SHADER_ID;
+		}
+		if (m_shader_data.size() <= m_shader_indices.capacity())
+		{
+			ShaderDescription sd;
+			m_shader_data.resize(m_shader_indices.capacity() + 1, sd);
+		}
+		uint32 idx = id.index();
 
 		// load & run lua script describing the shader
 		lua::Value config = m_fun_load_file.call(lua_file_path);
@@ -213,7 +227,7 @@ namespace arc { namespace renderer { namespace gl44 {
 		{
 			String msg; config.get(msg);
 			LOG_INFO("Error loading lua shader config: \n", msg.c_str());
-			m_shader_indices.release(idx);
+			m_shader_indices.release(id.value());
 			return INVALID_SHADER_ID;
 		}
 
@@ -223,23 +237,26 @@ namespace arc { namespace renderer { namespace gl44 {
 		{
 			String msg; sources.get(msg);
 			LOG_INFO("Error generating shader code: \n", msg.c_str());
-			m_shader_indices.release(idx);
+			m_shader_indices.release(id.value());
 			return INVALID_SHADER_ID;
 		}
 
-		arc::String vertex_source;
-		if (!sources.select("vertex").get(vertex_source))
+		// the sources and names are only needed until the program is linked
+		memory::ScratchScope scratch;
+
+		StringView vertex_source;
+		if (!sources.select("vertex").get(vertex_source, scratch.allocator()))
 		{
 			LOG_ERROR("Could not retrieve vertex shader code");
-			m_shader_indices.release(idx);
+			m_shader_indices.release(id.value());
 			return INVALID_SHADER_ID;
 		}
 
-		arc::String fragment_source;
-		if (!sources.select("fragment").get(fragment_source))
+		StringView fragment_source;
+		if (!sources.select("fragment").get(fragment_source, scratch.allocator()))
 		{
 			LOG_ERROR("Could not retrieve fragment shader code");
-			m_shader_indices.release(idx);
+			m_shader_indices.release(id.value());
 			return INVALID_SHADER_ID;
 		}
 
@@ -264,7 +281,7 @@ namespace arc { namespace renderer { namespace gl44 {
 
 			gl::delete_shader(vert_id);
 			gl::delete_shader(frag_id);
-			m_shader_indices.release(idx);
+			m_shader_indices.release(id.value());
 			return INVALID_SHADER_ID;
 		}
 
@@ -275,7 +292,7 @@ namespace arc { namespace renderer { namespace gl44 {
 
 			gl::delete_shader(vert_id);
 			gl::delete_shader(frag_id);
-			m_shader_indices.release(idx);
+			m_shader_indices.release(id.value());
 			return INVALID_SHADER_ID;
 		}
 
@@ -294,13 +311,13 @@ namespace arc { namespace renderer { namespace gl44 {
 		for (auto& v : lua::each_value(inputs))
 		{
 			// get the pretty name and hash it
-			String name;
-			String mangled_name;
+			StringView name;
+			StringView mangled_name("");
 			bool is_float;
 
-			v.select("var_name").get(name);
+			v.select("var_name").get(name, scratch.allocator());
 			// get the mangled name
-			v.select("gen_name").get(mangled_name);
+			v.select("gen_name").get(mangled_name, scratch.allocator());
 			v.select("is_float").get(is_float);
 
 			gl::bind_attribute_location(program_id, next_location, mangled_name.c_str());
@@ -342,14 +359,14 @@ namespace arc { namespace renderer { namespace gl44 {
 		auto vert_inst_uniforms = config.select("vertex").select("uniforms").select("instance");
 		for (auto& v : lua::each_value(vert_inst_uniforms))
 		{
-			String name;
+			StringView name;
 			int32 binding;
 			int32 type;
 
 			auto& iub = sd.instance_uniform_blocks[i];
 			auto& iu = sd.instance_uniforms[i];
 
-			v.select("var_name").get(name);
+			v.select("var_name").get(name, scratch.allocator());
 			v.select("binding").get(binding);
 			v.select("type").get(type);
 			uint32 stride = type_stride[type];
@@ -372,14 +389,14 @@ namespace arc { namespace renderer { namespace gl44 {
 		auto frag_inst_uniforms = config.select("fragment").select("uniforms").select("instance");
 		for (auto& v : lua::each_value(frag_inst_uniforms))
 		{
-			String name;
+			StringView name;
 			int32 binding;
 			int32 type;
 
 			auto& iub = sd.instance_uniform_blocks[i];
 			auto& iu = sd.instance_uniforms[i];
 
-			v.select("var_name").get(name);
+			v.select("var_name").get(name, scratch.allocator());
 			v.select("binding").get(binding);
 			v.select("type").get(type);
 			uint32 stride = type_stride[type];
@@ -403,6 +420,17 @@ namespace arc { namespace renderer { namespace gl44 {
 		sd.instance_uniforms_count = i;
 		sd.instance_uniform_draw_data_size = draw_data_offset;
 
+		// index the uniforms by name, a name used in both stages maps to the vertex one
+		ShaderDescription::UniformIndex::Entry uniform_names[MAX_INSTANCE_UNIFORMS];
+		uint32 name_count = 0;
+		for (uint32 u = 0; u < sd.instance_uniforms_count; u++)
+		{
+			bool known = false;
+			for (uint32 n = 0; n < name_count; n++) known = known || uniform_names[n].key == sd.instance_uniforms[u].name;
+			if (!known) uniform_names[name_count++] = { sd.instance_uniforms[u].name, (uint8)u };
+		}
+		sd.instance_uniform_indexed = sd.instance_uniform_index.build(Slice<const ShaderDescription::UniformIndex::Entry>(uniform_names, name_count));
+
 		sd.maximum_batch_size = m_max_uniform_buffer_size / max_block_stride;
 		sd.maximum_batch_size = arc::min(sd.maximum_batch_size, 128); // somehow I get errors with batch sizes > 128
 
@@ -418,20 +446,20 @@ namespace arc { namespace renderer { namespace gl44 {
 			auto log = gl::shader_info_log(vert_id);
 			LOG_INFO("Error linking shader: \n", log.c_str());
 			gl::delete_program(program_id);
-			m_shader_indices.release(idx);
+			m_shader_indices.release(id.value());
 			return INVALID_SHADER_ID;
 		}
 
 		m_shader_data[idx].gl_program_id = program_id;
 		LOG_INFO("Loaded shader: ", lua_file_path);
 
-		return ShaderID(idx);
+		return id;
 	}
 
 	bool ShaderBackend::initialize(const Config& config, const AllocatorConfig& allocator_config)
 	{
-		uint32 last_id_before_increment = 16;
-		uint32 id_size_increment = 16;
+		uint32 initial_shader_count = 16;
+		uint32 shader_count_increment = 16;
 
 
 		// load lua standard libs
@@ -463,19 +491,14 @@ namespace arc { namespace renderer { namespace gl44 {
 
 		m_shader_indices.initialize(
 			allocator_config.longterm_allocator,
-			last_id_before_increment,
-			id_size_increment,
+			initial_shader_count,
 			10000,
-			[this](uint32 new_last_id)
-		{
-			ShaderDescription sd;
-			m_shader_data.resize(new_last_id+1, sd);
-		}
+			handle_pool::LinearGrowth(shader_count_increment)
 		);
 
 		m_shader_data.initialize(allocator_config.longterm_allocator);
 		ShaderDescription sd;
-		m_shader_data.resize(1 + last_id_before_increment, sd);
+		m_shader_data.resize(1 + initial_shader_count, sd);
 
 		auto success = m_iu_submission.initialize(config,allocator_config);
 
@@ -495,13 +518,21 @@ namespace arc { namespace renderer { namespace gl44 {
 	int32 ShaderBackend::get_uniform_offset(ShaderID shader_id, ShaderUniformType uniform_type, ShaderPrimitiveType type, StringHash32 name)
 	{
 		ARC_ASSERT(m_shader_indices.valid(shader_id.value()), "Invalid ShaderID");
-		auto& sd = m_shader_data[shader_id.value()];
+		auto& sd = m_shader_data[shader_id.index()];
 
 		// right now we only support instanced uniforms
 		if (uniform_type == ShaderUniformType::Instanced)
 		{
-			// iterate over all instance uniforms, looking for one with fitting name and type
-			for (uint32 i = 0; i < sd.instance_uniforms_count; i++)
+			uint32 first = 0;
+			if (sd.instance_uniform_indexed)
+			{
+				auto idx = sd.instance_uniform_index.lookup(name);
+				if (idx == nullptr) return -1;
+				first = *idx;
+			}
+
+			// the first uniform with that name may have another type, look at the later ones too
+			for (uint32 i = first; i < sd.instance_uniforms_count; i++)
 			{
 				auto& u = sd.instance_uniforms[i];
 				if (u.name == name && u.type == type)
@@ -3,6 +3,8 @@
 #include "arc/common.hpp"
 #include "arc/hash/StringHash.hpp"
 #include "arc/collections/Array.hpp"
+#include "arc/collections/SmallArray.hpp"
+#include "arc/collections/StaticPerfectMap.hpp"
 #include "arc/util/IndexPool.hpp"
 #include "arc/lua/State.hpp"
 
@@ -56,6 +58,9 @@ namespace gl44 {
 
 		Uniform instance_uniforms[MAX_INSTANCE_UNIFORMS];
 		uint32 instance_uniforms_count = 0;
+		using UniformIndex = StaticPerfectMap<StringHash32, uint8, MAX_INSTANCE_UNIFORMS>;
+		UniformIndex instance_uniform_index;	// name -> first uniform with that name
+		bool instance_uniform_indexed = false;	// otherwise get_uniform_offset() scans instance_uniforms
 
 		uint32 gl_program_id;
 		uint32 instance_uniform_draw_data_size;
@@ -112,9 +117,9 @@ namespace gl44 {
 		uint32     m_block_count = 0;
 		uint32	   m_max_buffer_size = 1024 * 1024;		// 1MB;
 		uint32     m_map_buffer_alignment;
-		Array<uint32> m_available_buffers;				// OpenGL ids of unused buffers
+		SmallArray<uint32, 16> m_available_buffers;		// OpenGL ids of unused buffers
 		BufferState m_current_buffer;					// buffer memory requests are taken from this buffer until it is filled
-		Array<UsedBuffer> m_used_buffers;				// buffers that need to be flushed before rendering and orphaned after rendering
+		SmallArray<UsedBuffer, 16> m_used_buffers;		// buffers that need to be flushed before rendering and orphaned after rendering
 	};
 
 	/* Main class managing everything shader related. */
@@ -129,7 +134,7 @@ namespace gl44 {
 		int32 get_uniform_offset(ShaderID shader_id, ShaderUniformType uniform_type, ShaderPrimitiveType type, StringHash32 name);
 	public:
 		Array<ShaderDescription> m_shader_data;
-		IndexPool32 m_shader_indices;
+		ShaderID::Pool m_shader_indices;
 	public:
 		InstanceUniformSubmission m_iu_submission;
 	public:
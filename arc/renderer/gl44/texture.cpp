@@ -1,7 +1,7 @@
 #pragma once
 
 #include "texture.hpp"
-#include "arc/collections/HashMap.inl"
+#include "arc/collections/ConcurrentHashMap.inl"
 #include "arc/renderer/RendererConfig.hpp"
 
 
@@ -57,9 +57,9 @@ namespace arc { namespace renderer { namespace gl44 {
 	bool TextureManager::set_data(TextureHandle h, const Slice<vec4u8> data, uint32_t offset_x, uint32 count_x)
 	{
 		// lookup meta info
-		auto entry = m_tex_handle_to_info.lookup(h.value());
-		if (entry == nullptr) return false;
-		auto& info = entry->value();
+		auto info_ptr = m_tex_handle_to_info.lookup(h.value());
+		if (info_ptr == nullptr) return false;
+		auto& info = *info_ptr;
 
 		// check for valid input parameters
 		if (info.type != TextureType::Texure1D) return false;
@@ -76,9 +76,9 @@ namespace arc { namespace renderer { namespace gl44 {
 	bool TextureManager::set_data(TextureHandle h, const Slice<vec4u8> data, uint32_t offset_x, uint32 count_x, uint32_t offset_y, uint32_t count_y)
 	{
 		// lookup meta info
-		auto entry = m_tex_handle_to_info.lookup(h.value());
-		if (entry == nullptr) return false;
-		auto& info = entry->value();
+		auto info_ptr = m_tex_handle_to_info.lookup(h.value());
+		if (info_ptr == nullptr) return false;
+		auto& info = *info_ptr;
 
 		// check for valid input parameters
 		if (info.type != TextureType::Texure2D) return false;
@@ -96,9 +96,7 @@ namespace arc { namespace renderer { namespace gl44 {
 	bool TextureManager::valid(TextureHandle h) const
 	{
 		if (h.value() == 0) return false;
-		auto entry = m_tex_handle_to_info.lookup(h.value());
-		if (entry == nullptr) return false;
-		return true;
+		return m_tex_handle_to_info.contains(h.value());
 	}
 
 }}}
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "arc/common.hpp"
-#include "arc/collections/HashMap.hpp"
+#include "arc/collections/ConcurrentHashMap.hpp"
 #include "arc/gl/types.hpp"
 #include "arc/gl/functions.hpp"
 
@@ -68,7 +68,7 @@ namespace gl44 {
 			uint32_t mip_levels;
 		};
 
-		arc::HashMap<TextureInfo> m_tex_handle_to_info;
+		arc::ConcurrentHashMap<TextureInfo> m_tex_handle_to_info;	// read from any thread, written at load time
 	};
 
 }
@@ -6,11 +6,12 @@ namespace arc { namespace renderer {
 
 	// ID types ///////////////////////////////////////////////////////////////////////
 
-	DECLARE_ID32(GeometryID);
+	// shader and geometry config handles are stored in the 24 and 8 bit fields of the sort key
+	DECLARE_ID32_BITS(GeometryID, 26, 6);
 	DECLARE_ID32(VertexLayoutID);
-	DECLARE_ID32(ShaderID);
+	DECLARE_ID32_BITS(ShaderID, 16, 8);
 	DECLARE_ID32(RenderPassID);
-	DECLARE_ID32(GeometryConfigID);
+	DECLARE_ID32_BITS(GeometryConfigID, 7, 1);
 
 	static const GeometryID       INVALID_GEOMETRY_ID = GeometryID(0);
 	static const VertexLayoutID   INVALID_VERTEX_LAYOUT_ID = VertexLayoutID(0);
@@ -20,7 +20,18 @@ namespace arc
 
     namespace asi = arc::string_implementation;
 
-    static memory::Mallocator _g_string_allocator;
+    static memory::Mallocator _g_string_mallocator;
+    static memory::Allocator* _g_string_allocator = &_g_string_mallocator;
+
+    void String::set_allocator(memory::Allocator* alloc)
+    {
+        _g_string_allocator = alloc != nullptr ? alloc : &_g_string_mallocator;
+    }
+
+    memory::Allocator& String::allocator()
+    {
+        return *_g_string_allocator;
+    }
 
     String::String()
     {}
@@ -30,7 +41,7 @@ namespace arc
         if (n == 0) return;
 
         auto HEADER_SIZE = sizeof(asi::header);
-        _data = (asi::header*)_g_string_allocator.allocate(HEADER_SIZE+n+1, alignof(asi::header));
+        _data = (asi::header*)_g_string_allocator->allocate(HEADER_SIZE+n+1, alignof(asi::header));
         _data->ref_count = 1;
         _data->length = n;
         std::memcpy(str_data(),s,n);
@@ -74,6 +85,33 @@ namespace arc
         return *this;
     }
 
+    void String::assign(const char* s, uint32 n)
+    {
+        if (n == 0)
+        {
+            decrease_ref_count();
+            _data = nullptr;
+            return;
+        }
+
+        auto HEADER_SIZE = sizeof(asi::header);
+        if (_data != nullptr && _data->ref_count == 1)
+        {
+            // sole owner, the allocator might resize the buffer in place
+            _data = (asi::header*)_g_string_allocator->reallocate(_data, HEADER_SIZE+_data->length+1, HEADER_SIZE+n+1, alignof(asi::header));
+        }
+        else
+        {
+            decrease_ref_count();
+            _data = (asi::header*)_g_string_allocator->allocate(HEADER_SIZE+n+1, alignof(asi::header));
+            _data->ref_count = 1;
+        }
+
+        _data->length = n;
+        std::memcpy(str_data(),s,n);
+        str_data()[n] = '\0';
+    }
+
     const char *String::c_str() const
     {
         return _data == nullptr ? "" : str_data();
@@ -99,7 +137,7 @@ namespace arc
         if (n == 0) return str;
 
         auto HEADER_SIZE = sizeof(asi::header);
-        str._data = (asi::header*)_g_string_allocator.allocate(HEADER_SIZE+n+1,alignof(asi::header));
+        str._data = (asi::header*)_g_string_allocator->allocate(HEADER_SIZE+n+1,alignof(asi::header));
         str._data->ref_count = 1;
         str._data->length = n;
         str.str_data()[n] = '\0';
@@ -120,7 +158,7 @@ namespace arc
             ARC_ASSERT(_data->ref_count >= 0, "String: invalid ref-count.");
             if (_data->ref_count == 0)
             {
-                _g_string_allocator.free(_data);
+                _g_string_allocator->free(_data);
                 _data = nullptr;
             }
         }
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "arc/core/numeric_types.hpp"
+#include "arc/core/type_traits.hpp"
 
 namespace arc
 {
     namespace string_implementation { struct header; }
+    namespace memory { class Allocator; }
     class StringView;
 
 	/* A heap allocated String that uses reference counting. */
@@ -20,6 +22,9 @@ namespace arc
         template<uint32 N>
         explicit String( const char ( &s )[N] ) : String(s,N-1) {}
 
+    public:
+        using TriviallyRelocatable = std::true_type;
+
     public:
         ~String();
         String& operator=(const String& other);
@@ -30,12 +35,24 @@ namespace arc
         const char* c_str() const;
         uint32 length() const;
 
+    public:
+        /// replaces the content, reuses the buffer if this is its only reference
+        /// s must not point into this string
+        void assign(const char* s, uint32 n);
+
     public:
         bool operator==(const String& other) const;
 
     public:
         static String _Make_Raw(uint32 n);
 
+    public:
+        /// Allocator used for the character data of all strings, nullptr restores the default.
+        /// Has to be set before the first String is allocated, strings are freed with the
+        /// allocator that is set at that time.
+        static void set_allocator(memory::Allocator* alloc);
+        static memory::Allocator& allocator();
+
     private:
         void increase_ref_count() const;
         void decrease_ref_count();
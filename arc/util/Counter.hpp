@@ -16,7 +16,7 @@ namespace arc
 		inline void increment() { m_value += 1; }
 		inline void decrement() { m_value -= 1; }
 	private:
-		uint32 m_value;
+		uint32 m_value = 0;
 	};
 
 
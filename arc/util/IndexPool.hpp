@@ -1,140 +1,375 @@
 #pragma once
 
 #include "arc/common.hpp"
-#include "arc/collections/Queue.hpp"
+#include "arc/collections/Slice.hpp"
 #include "arc/collections/Array.hpp"
+#include "arc/collections/ChunkedArray.hpp"
+#include <algorithm>
 #include <functional>
 
 namespace arc
 {
-	// handle ///////////////////////////
+	// handle pool ///////////////////////////
 
-	template<typename TAG>
-	struct Index32
+	namespace handle_pool
+	{
+		/// Adds a fixed number of handles whenever the pool runs out.
+		struct LinearGrowth
+		{
+			explicit LinearGrowth(uint32 increment = 128) : increment(increment) {}
+			uint64 next_capacity(uint64 capacity) const { return capacity + increment; }
+
+			uint32 increment;
+		};
+
+		/// Doubles the number of handles whenever the pool runs out.
+		struct DoublingGrowth
+		{
+			uint64 next_capacity(uint64 capacity) const { return capacity < 16 ? 16 : capacity * 2; }
+		};
+	}
+
+	/* Hands out uint32 handles made of an index in the low INDEX_BITS and a generation above it.
+	 *
+	 * Every index has one slot. A live slot stores its handle, so valid() is a single compare and
+	 * rejects handles of released indices as soon as the index is reused with the next generation.
+	 * Free slots form an intrusive FIFO list through their index bits, released indices are
+	 * reused last, which makes the generations wrap as slowly as possible. A handle kept across
+	 * 2^GENERATION_BITS reuses of its index becomes valid again.
+	 *
+	 * Index 0 is never handed out, so 0 is the invalid handle. When the free list is empty the
+	 * pool grows by Growth::next_capacity() up to max_capacity. It does not notify anyone,
+	 * storage indexed by handle index has to hold capacity() + 1 entries after create(). */
+	template<uint32 INDEX_BITS, uint32 GENERATION_BITS, typename Growth = handle_pool::LinearGrowth>
+	class HandlePool32
 	{
+		static_assert(INDEX_BITS > 0 && GENERATION_BITS > 0 && INDEX_BITS + GENERATION_BITS <= 32, "Invalid handle layout.");
 	public:
-		inline uint32 value() const { return m_value; }
+		static const uint32 INVALID_HANDLE = 0;
+		static const uint32 INDEX_MASK = (1u << INDEX_BITS) - 1;
+		static const uint32 GENERATION_MASK = (uint32)((1ull << GENERATION_BITS) - 1);
+		static const uint32 MAX_CAPACITY = INDEX_MASK;
+
+		static uint32 index(uint32 handle) { return handle & INDEX_MASK; }
+		static uint32 generation(uint32 handle) { return (handle >> INDEX_BITS) & GENERATION_MASK; }
 	public:
-		Index32() = default;
-		inline explicit Index32(uint32 v) : m_value(v) {}
+		HandlePool32() = default;
+		~HandlePool32();
+	public:
+		ARC_NO_COPY(HandlePool32);
+	public:
+		void initialize(memory::Allocator* alloc, uint32 capacity, uint32 max_capacity = MAX_CAPACITY, Growth growth = Growth());
+		void finalize();
+		bool is_initialized() const;
+	public:
+		/// Returns INVALID_HANDLE if max_capacity handles are in use.
+		uint32 create();
+		/// Returns false if the handle was not valid.
+		bool release(uint32 handle);
+		bool valid(uint32 handle) const;
+		/// The live handle of an index, INVALID_HANDLE if the index is free.
+		uint32 handle_at(uint32 idx) const;
 	public:
-		inline bool operator==(Index32<TAG> other) const { return m_value == other.m_value; }
-		inline bool operator!=(Index32<TAG> other) const { return m_value != other.m_value; }
+		/// Fills o_handles, resizes at most once. Returns how many were created.
+		uint32 create_n(Slice<uint32> o_handles);
+		/// Returns how many of the handles were valid and released.
+		uint32 release_n(Slice<const uint32> handles);
+	public:
+		/// Handles in use.
+		uint32 size() const;
+		/// Highest index that may be handed out without growing.
+		uint32 capacity() const;
 	private:
-		uint32 m_value;
+		bool grow(uint32 min_free);
+		void extend(uint32 new_capacity);
+		uint32 pop_free();
+	private:
+		Array<uint32> m_slots;			// live: the handle, free: the next generation and the next free index
+		uint32 m_first_free = 0;
+		uint32 m_last_free = 0;
+		uint32 m_size = 0;
+		uint32 m_max_capacity = 0;
+		Growth m_growth;
 	};
 
-	// pools ///////////////////////////
+	// handle ///////////////////////////
 
-	class IndexPool32
+	template<typename TAG, uint32 INDEX_BITS = 24, uint32 GENERATION_BITS = 8>
+	struct Index32
 	{
 	public:
-		void initialize(memory::Allocator* alloc, uint32 last_id, uint32 increment, uint32 very_last_id, std::function<void(uint32)> increment_cb = nullptr);
-		void finalize();
-		bool is_initialized();
+		using Pool = HandlePool32<INDEX_BITS, GENERATION_BITS>;
 	public:
-		uint32 create();
-		void release(uint32 h);
-		bool valid(uint32 idx) const;
+		inline uint32 value() const { return m_value; }
+		inline uint32 index() const { return Pool::index(m_value); }
+		inline uint32 generation() const { return Pool::generation(m_value); }
+	public:
+		Index32() = default;
+		inline explicit Index32(uint32 v) : m_value(v) {}
+	public:
+		inline bool operator==(Index32 other) const { return m_value == other.m_value; }
+		inline bool operator!=(Index32 other) const { return m_value != other.m_value; }
 	private:
-		Queue<uint32> m_free_handles;
-		uint32  m_next_id = 0;
-		uint32  m_increment = 0;
-		uint32  m_last_id = 0;
-		uint32  m_very_last_id = 0;
-		std::function<void(uint32)> m_resize_cb = nullptr;
-		bool m_initialized = false;
+		uint32 m_value;
 	};
 
-	template<typename T>
+	// compact pool ///////////////////////////
+
+	/* Stores T contiguously, ids are handles of Pool and stay valid while the data moves.
+	 * Growing never moves elements, but release() moves the last element into the freed place,
+	 * so pointers from create() and data() stay valid until the next release(). */
+	template<typename T, typename Pool = HandlePool32<24, 8>>
 	class CompactPool
 	{
 	public:
-		CompactPool(memory::Allocator* alloc, uint32_t initial_size, uint32_t increment, uint32_t max_size = (uint32_t)-1);
+		CompactPool(memory::Allocator* alloc, uint32_t initial_size, uint32_t increment, uint32_t max_size = Pool::MAX_CAPACITY);
 	public:
 		arc::tuple<uint32_t, T*> create();
-		void release(uint32_t idx);
-		bool valid(uint32_t idx) const;
+		void release(uint32_t id);
+		bool valid(uint32_t id) const;
 	public:
-		T* data(uint32_t idx);
-		const T* data(uint32_t idx) const;
+		T* data(uint32_t id);
+		const T* data(uint32_t id) const;
 	public:
 		uint32_t find(std::function<bool(const T&)> cb);
 	private:
-		Array<uint32_t> m_indirection;
-		Array<T> m_data;
-		Array<uint32_t> m_back_indices;
-		IndexPool32 m_indices;
+		Array<uint32_t> m_indirection;	// by handle index
+		ChunkedArray<T> m_data;			// grows without moving, pointers from create() stay valid until the next release()
+		Array<uint32_t> m_back_ids;		// handle of each element of m_data
+		Pool m_ids;
 	};
 
 	// macro ///////////////////////////
 
 	#define DECLARE_ID32(Name)					\
+		DECLARE_ID32_BITS(Name, 24, 8)
+
+	#define DECLARE_ID32_BITS(Name, INDEX_BITS, GENERATION_BITS)	\
 		struct _##Name##_IDTAG {};				\
-		using Name = Index32<_##Name##_IDTAG>;
+		using Name = Index32<_##Name##_IDTAG, INDEX_BITS, GENERATION_BITS>;
 
 
 	// template implementation //////////////////////////
 
-	template<typename T>
-	CompactPool<T>::CompactPool(memory::Allocator* alloc, uint32_t initial_size, uint32_t increment, uint32_t max_size)
-		: m_indirection(*alloc, initial_size + 1), m_data(*alloc), m_back_indices(*alloc)
+	template<uint32 I, uint32 G, typename Growth>
+	HandlePool32<I, G, Growth>::~HandlePool32()
+	{
+		finalize();
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	void HandlePool32<I, G, Growth>::initialize(memory::Allocator* alloc, uint32 capacity, uint32 max_capacity, Growth growth)
+	{
+		finalize();
+
+		m_max_capacity = max_capacity < MAX_CAPACITY ? max_capacity : MAX_CAPACITY;
+		m_growth = growth;
+
+		// slot 0 never matches a handle, index 0 is never handed out
+		m_slots.initialize(alloc);
+		m_slots.push_back(~0u);
+		extend(capacity < m_max_capacity ? capacity : m_max_capacity);
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	void HandlePool32<I, G, Growth>::finalize()
+	{
+		m_slots.finalize();
+		m_first_free = 0;
+		m_last_free = 0;
+		m_size = 0;
+		m_max_capacity = 0;
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	bool HandlePool32<I, G, Growth>::is_initialized() const
+	{
+		return m_slots.size() != 0;
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	uint32 HandlePool32<I, G, Growth>::create()
 	{
-		m_indices.initialize(alloc, initial_size, increment, max_size - 1, [this](uint32 lastId) { m_indirection.resize(lastId + 1); });
+		if (m_first_free == 0 && !grow(1)) return INVALID_HANDLE;
+		return pop_free();
 	}
 
-	template<typename T>
-	tuple<uint32_t,T*> CompactPool<T>::create()
+	template<uint32 I, uint32 G, typename Growth>
+	bool HandlePool32<I, G, Growth>::release(uint32 handle)
 	{
-		auto idx = m_indices.create();
-		m_indirection[idx] = m_data.size();
-		m_data.push_back();
-		m_back_indices.push_back(idx);
-		return std::make_tuple(idx, &m_data.back());
+		if (!valid(handle)) return false;
+
+		// the generation advances now, stale handles fail from here on
+		uint32 idx = index(handle);
+		m_slots[idx] = ((generation(handle) + 1) & GENERATION_MASK) << I;
+
+		if (m_last_free != 0) m_slots[m_last_free] |= idx;
+		else m_first_free = idx;
+		m_last_free = idx;
+
+		m_size -= 1;
+		return true;
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	bool HandlePool32<I, G, Growth>::valid(uint32 handle) const
+	{
+		uint32 idx = index(handle);
+		return idx < m_slots.size() && m_slots[idx] == handle;
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	uint32 HandlePool32<I, G, Growth>::handle_at(uint32 idx) const
+	{
+		if (idx == 0 || idx >= m_slots.size()) return INVALID_HANDLE;
+
+		// a free slot links to another index, a live one to itself
+		uint32 slot = m_slots[idx];
+		return index(slot) == idx ? slot : INVALID_HANDLE;
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	uint32 HandlePool32<I, G, Growth>::create_n(Slice<uint32> o_handles)
+	{
+		uint32 n = (uint32)o_handles.size();
+		uint32 free_count = capacity() - m_size;
+		if (free_count < n && grow(n - free_count)) free_count = capacity() - m_size;
+
+		n = std::min(n, free_count);
+		for (uint32 i = 0; i < n; i++) o_handles[i] = pop_free();
+		return n;
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	uint32 HandlePool32<I, G, Growth>::release_n(Slice<const uint32> handles)
+	{
+		uint32 count = 0;
+		for (uint32 handle : handles) count += release(handle) ? 1 : 0;
+		return count;
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	uint32 HandlePool32<I, G, Growth>::size() const
+	{
+		return m_size;
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	uint32 HandlePool32<I, G, Growth>::capacity() const
+	{
+		return m_slots.size() == 0 ? 0 : m_slots.size() - 1;
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	bool HandlePool32<I, G, Growth>::grow(uint32 min_free)
+	{
+		uint64 old_capacity = capacity();
+		uint64 wanted = old_capacity + min_free;
+		uint64 new_capacity = old_capacity;
+		while (new_capacity < wanted && new_capacity < m_max_capacity)
+		{
+			new_capacity = std::max(m_growth.next_capacity(new_capacity), new_capacity + 1);
+		}
+		new_capacity = std::min(new_capacity, (uint64)m_max_capacity);
+		if (new_capacity == old_capacity) return false;
+
+		extend((uint32)new_capacity);
+		return true;
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	void HandlePool32<I, G, Growth>::extend(uint32 new_capacity)
+	{
+		if (new_capacity <= capacity()) return;
+
+		// new indices start at generation 0 and are appended to the free list in order
+		uint32 first = capacity() + 1;
+		uint32 last = new_capacity;
+		m_slots.resize(last + 1);
+		for (uint32 i = first; i < last; i++) m_slots[i] = i + 1;
+		m_slots[last] = 0;
+
+		if (m_last_free != 0) m_slots[m_last_free] |= first;
+		else m_first_free = first;
+		m_last_free = last;
+	}
+
+	template<uint32 I, uint32 G, typename Growth>
+	uint32 HandlePool32<I, G, Growth>::pop_free()
+	{
+		uint32 idx = m_first_free;
+		uint32 slot = m_slots[idx];
+
+		m_first_free = index(slot);
+		if (m_first_free == 0) m_last_free = 0;
+
+		uint32 handle = (slot & ~INDEX_MASK) | idx;
+		m_slots[idx] = handle;
+		m_size += 1;
+		return handle;
+	}
+
+	template<typename T, typename Pool>
+	CompactPool<T, Pool>::CompactPool(memory::Allocator* alloc, uint32_t initial_size, uint32_t increment, uint32_t max_size)
+		: m_indirection(*alloc, initial_size + 1), m_data(*alloc), m_back_ids(*alloc)
+	{
+		m_ids.initialize(alloc, initial_size, max_size, handle_pool::LinearGrowth(increment));
+	}
+
+	template<typename T, typename Pool>
+	tuple<uint32_t,T*> CompactPool<T, Pool>::create()
+	{
+		auto id = m_ids.create();
+		ARC_ASSERT(id != Pool::INVALID_HANDLE, "CompactPool is full");
+		if (m_indirection.size() <= m_ids.capacity()) m_indirection.resize(m_ids.capacity() + 1);
+
+		m_indirection[Pool::index(id)] = m_data.size();
+		m_data.emplace_back();
+		m_back_ids.push_back(id);
+		return std::make_tuple(id, &m_data.back());
 	}
 
-	template<typename T>
-	void CompactPool<T>::release(uint32_t idx)
+	template<typename T, typename Pool>
+	void CompactPool<T, Pool>::release(uint32_t id)
 	{
-		ARC_ASSERT(valid(idx), "invalid index");
-		uint32_t data_idx = m_indirection[idx];
-		m_data[data_idx] = std::move(m_data.back());
-		m_indirection[m_back_indices.back()] = data_idx;
+		ARC_ASSERT(valid(id), "invalid id");
+		uint32_t data_idx = m_indirection[Pool::index(id)];
+		m_indirection[Pool::index(m_back_ids.back())] = data_idx;
+		m_back_ids[data_idx] = m_back_ids.back();
 
-		m_data.pop_back();
-		m_back_indices.pop_back();
+		m_data.swap_remove(data_idx);
+		m_back_ids.pop_back();
 
-		m_indirection[idx] = (uint32_t)-1;
-		m_indices.release(idx);
+		m_ids.release(id);
 	}
 
-	template<typename T>
-	bool CompactPool<T>::valid(uint32_t idx) const
+	template<typename T, typename Pool>
+	bool CompactPool<T, Pool>::valid(uint32_t id) const
 	{
-		return m_indices.valid(idx) && m_indirection[idx] != (uint32_t)-1;
+		return m_ids.valid(id);
 	}
 
-	template<typename T>
-	T* CompactPool<T>::data(uint32_t idx)
+	template<typename T, typename Pool>
+	T* CompactPool<T, Pool>::data(uint32_t id)
 	{
-		ARC_ASSERT(valid(idx), "invalid index");
-		return &m_data[m_indirection[idx]];
+		ARC_ASSERT(valid(id), "invalid id");
+		return &m_data[m_indirection[Pool::index(id)]];
 	}
 
-	template<typename T>
-	const T* CompactPool<T>::data(uint32_t idx) const
+	template<typename T, typename Pool>
+	const T* CompactPool<T, Pool>::data(uint32_t id) const
 	{
-		ARC_ASSERT(valid(idx), "invalid index");
-		return &m_data[m_indirection[idx]];
+		ARC_ASSERT(valid(id), "invalid id");
+		return &m_data[m_indirection[Pool::index(id)]];
 	}
 
-	template<typename T>
-	uint32_t CompactPool<T>::find(std::function<bool(const T&)> cb)
+	template<typename T, typename Pool>
+	uint32_t CompactPool<T, Pool>::find(std::function<bool(const T&)> cb)
 	{
 		for (uint32_t i = 0; i < m_data.size(); i++)
 		{
-			if (cb(m_data[i])) return m_back_indices[i];
+			if (cb(m_data[i])) return m_back_ids[i];
 		}
-		return 0;
+		return Pool::INVALID_HANDLE;
 	}
 }
\ No newline at end of file
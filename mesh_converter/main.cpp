@@ -7,6 +7,7 @@
 #include "arc/io/FileStream.hpp"
 #include "arc/io/SimpleMesh.hpp"
 #include "arc/memory/util.hpp"
+#include "arc/memory/scratch.hpp"
 #include "arc/math/common.hpp"
 #include "arc/hash/StringHash.hpp"
 #include "arc/string/StringView.hpp"
@@ -56,15 +57,15 @@ int main(int argc, char** argv)
 	uint32_t data_offset = sizeof(io::MeshHeader);
 	data_offset += mh.part_count*sizeof(io::PartHeader);
 
-	if (mh.part_count > 1024)
+	memory::ScratchScope scratch;
+	auto parts = scratch.allocator().create_n<io::PartHeader>(mh.part_count);
+	if (parts == nullptr)
 	{
-		std::cout << "[ERROR] Too many parts: " << mh.part_count << std::endl;
+		std::cout << "[ERROR] Could not allocate " << mh.part_count << " part headers" << std::endl;
 		system("pause");
 		return EXIT_FAILURE;
 	}
 
-	io::PartHeader parts[1024];
-
 	for (uint32_t mi=0; mi < scene->mNumMeshes; mi++)
 	{
 		auto& mesh = *scene->mMeshes[mi];
@@ -0,0 +1,111 @@
+#include "benchmark.hpp"
+
+#include "arc/common.hpp"
+#include "arc/memory/Allocator.hpp"
+#include "arc/memory/SlabAllocator.hpp"
+#include "arc/collections/Array.inl"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace arc;
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	// same layout as the header arc::String puts in front of its characters
+	struct StringHeader
+	{
+		int32  ref_count;
+		uint32 length;
+	};
+
+	// Array::_grow pattern: many small arrays growing one element at a time
+	void array_grow_pattern(memory::Allocator& alloc, uint32 rounds)
+	{
+		const uint32 ARRAY_COUNT = 256;
+		for (uint32 r = 0; r < rounds; r++)
+		{
+			Array<uint32> arrays[ARRAY_COUNT];
+			for (auto& a : arrays) a.initialize(&alloc);
+
+			for (uint32 i = 0; i < 64; i++)
+			{
+				for (uint32 k = 0; k < ARRAY_COUNT; k++)
+				{
+					// vary the final sizes a bit
+					if (i < 16 + (k % 48)) arrays[k].push_back(i);
+				}
+			}
+		}
+	}
+
+	// String::String(const char*, uint32) pattern: short strings with a rolling lifetime
+	void string_pattern(memory::Allocator& alloc, uint32 rounds)
+	{
+		const uint32 LIVE_COUNT = 1024;
+		void* live[LIVE_COUNT] = {};
+
+		uint32 rnd = 12345;
+		for (uint32 r = 0; r < rounds; r++)
+		{
+			for (uint32 i = 0; i < LIVE_COUNT; i++)
+			{
+				rnd = rnd * 1103515245 + 12345;
+				uint32 n = 4 + (rnd >> 16) % 60;
+
+				alloc.free(live[i]);
+				live[i] = alloc.allocate(sizeof(StringHeader) + n + 1, alignof(StringHeader));
+			}
+		}
+		for (auto p : live) alloc.free(p);
+	}
+
+	template<typename F>
+	double measure_ms(uint32 thread_count, F function)
+	{
+		auto begin = Clock::now();
+		if (thread_count == 1)
+		{
+			function();
+		}
+		else
+		{
+			std::vector<std::thread> threads;
+			for (uint32 i = 0; i < thread_count; i++) threads.emplace_back(function);
+			for (auto& t : threads) t.join();
+		}
+		auto end = Clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count();
+	}
+
+	void run(const char* name, uint32 thread_count, memory::Allocator& malloc, memory::Allocator& slab)
+	{
+		const uint32 ROUNDS = 200;
+
+		double grow_malloc = measure_ms(thread_count, [&]() { array_grow_pattern(malloc, ROUNDS); });
+		double grow_slab = measure_ms(thread_count, [&]() { array_grow_pattern(slab, ROUNDS); });
+		double str_malloc = measure_ms(thread_count, [&]() { string_pattern(malloc, ROUNDS); });
+		double str_slab = measure_ms(thread_count, [&]() { string_pattern(slab, ROUNDS); });
+
+		std::cout << name << " (" << thread_count << " threads)\n";
+		std::cout << "   Array::_grow    Mallocator: " << grow_malloc << "ms  SlabAllocator: " << grow_slab << "ms\n";
+		std::cout << "   String(s, n)    Mallocator: " << str_malloc << "ms  SlabAllocator: " << str_slab << "ms\n";
+	}
+}
+
+void slab_allocator_benchmark()
+{
+	std::cout << "<slab_allocator_benchmark_begin>" << std::endl;
+
+	memory::Mallocator malloc;
+	memory::SlabAllocator slab(&malloc);
+
+	run("single threaded", 1, malloc, slab);
+	run("multi threaded", 4, malloc, slab);
+
+	std::cout << "<slab_allocator_benchmark_end>" << "\n" << std::endl;
+}
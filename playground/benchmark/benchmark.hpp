@@ -0,0 +1,19 @@
+#pragma once
+
+void slab_allocator_benchmark();
+
+/* Replays an allocation trace saved by memory::TraceAllocator, or a synthetic one if the
+ * path is null or cannot be read. */
+void allocation_replay_benchmark(const char* trace_path = nullptr);
+
+/* Compares HashMap and FlatHashMap on the lookup patterns of the component backends and
+ * the texture manager. */
+void hashmap_benchmark();
+
+/* Messages per second through SpscQueue between two threads, single and batched, against
+ * a mutex protected Queue. */
+void spsc_queue_benchmark();
+
+/* Task throughput of MpmcQueue with 1 to 4 producers and consumers, single and bulk, against
+ * a mutex protected Queue. */
+void mpmc_queue_benchmark();
@@ -0,0 +1,285 @@
+#include "benchmark.hpp"
+
+#include "arc/common.hpp"
+#include "arc/memory/Allocator.hpp"
+#include "arc/collections/HashMap.inl"
+#include "arc/collections/ConcurrentHashMap.inl"
+#include "arc/collections/FlatHashMap.inl"
+#include "arc/collections/SparseSet.inl"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace arc;
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	// same size as TextureManager::TextureInfo
+	struct TextureInfo
+	{
+		uint32 gl_tex;
+		uint32 dim_x;
+		uint32 dim_y;
+		uint32 dim_z;
+		uint32 type;
+		uint32 mip_levels;
+	};
+
+	template<typename F>
+	double measure_ms(F function)
+	{
+		auto begin = Clock::now();
+		function();
+		auto end = Clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count();
+	}
+
+	// SimpleComponentBackend::get_component: entity index -> component index,
+	// a lookup per entity and frame, in entity order or scattered
+	template<typename Map>
+	double component_lookup(memory::Allocator& alloc, const std::vector<uint32>& order, uint32 rounds, uint64& checksum)
+	{
+		Map mapping(alloc);
+		for (uint32 i = 0; i < order.size(); i++) mapping.set(i, (int32)i);
+
+		return measure_ms([&]()
+		{
+			for (uint32 r = 0; r < rounds; r++)
+			{
+				for (auto index : order)
+				{
+					auto entry = mapping.lookup(index);
+					if (entry) checksum += entry->value();
+				}
+			}
+		});
+	}
+
+	// get_component through HashMap::lookup_batch
+	double component_lookup_batch(memory::Allocator& alloc, const std::vector<uint32>& order, uint32 rounds, uint64& checksum)
+	{
+		HashMap<uint64, int32> mapping(alloc);
+		for (uint32 i = 0; i < order.size(); i++) mapping.set(i, (int32)i);
+
+		const uint32 CHUNK_SIZE = 64;
+		uint64 keys[CHUNK_SIZE];
+		HashMap<uint64, int32>::Entry* entries[CHUNK_SIZE];
+
+		return measure_ms([&]()
+		{
+			for (uint32 r = 0; r < rounds; r++)
+			{
+				for (uint32 begin = 0; begin < order.size(); begin += CHUNK_SIZE)
+				{
+					uint32 n = std::min<uint32>(CHUNK_SIZE, (uint32)order.size() - begin);
+					for (uint32 i = 0; i < n; i++) keys[i] = order[begin + i];
+
+					mapping.lookup_batch(Slice<const uint64>(keys, n), make_slice(entries, n));
+					for (uint32 i = 0; i < n; i++) if (entries[i]) checksum += entries[i]->value();
+				}
+			}
+		});
+	}
+
+	// get_component through the SparseSet SimpleComponentBackend uses
+	double component_lookup_sparse(memory::Allocator& alloc, const std::vector<uint32>& order, uint32 rounds, uint64& checksum)
+	{
+		SparseSet mapping(alloc);
+		for (uint32 i = 0; i < order.size(); i++) mapping.insert(i);
+
+		return measure_ms([&]()
+		{
+			for (uint32 r = 0; r < rounds; r++)
+			{
+				for (auto index : order)
+				{
+					uint32 component = mapping.index_of(index);
+					if (component != SparseSet::INVALID_INDEX) checksum += component;
+				}
+			}
+		});
+	}
+
+	// TextureManager::set_data: a few hundred gl texture names, hot lookups, some misses
+	template<typename Map>
+	double texture_lookup(memory::Allocator& alloc, uint32 rounds, uint64& checksum)
+	{
+		const uint32 TEXTURE_COUNT = 300;
+
+		Map textures(alloc);
+		for (uint32 i = 1; i <= TEXTURE_COUNT; i++) textures.set(i, TextureInfo{ i, 256, 256, 1, 1, 9 });
+
+		return measure_ms([&]()
+		{
+			uint32 rnd = 12345;
+			for (uint32 r = 0; r < rounds; r++)
+			{
+				rnd = rnd * 1103515245 + 12345;
+				uint64 handle = 1 + (rnd >> 16) % (TEXTURE_COUNT + TEXTURE_COUNT / 10);
+				auto entry = textures.lookup(handle);
+				if (entry) checksum += entry->value().dim_x;
+			}
+		});
+	}
+
+	// the same lookups from several threads at once, lookup(handle) returns a TextureInfo or nullptr
+	template<typename F>
+	double parallel_texture_lookup(uint32 thread_count, uint32 rounds, uint64& checksum, F lookup)
+	{
+		const uint32 TEXTURE_COUNT = 300;
+		std::atomic<uint64> sum(0);
+
+		double ms = measure_ms([&]()
+		{
+			std::vector<std::thread> threads;
+			for (uint32 t = 0; t < thread_count; t++)
+			{
+				threads.emplace_back([&, t]()
+				{
+					uint64 local = 0;
+					uint32 rnd = 12345 + t;
+					for (uint32 r = 0; r < rounds; r++)
+					{
+						rnd = rnd * 1103515245 + 12345;
+						uint64 handle = 1 + (rnd >> 16) % (TEXTURE_COUNT + TEXTURE_COUNT / 10);
+						const TextureInfo* info = lookup(handle);
+						if (info) local += info->dim_x;
+					}
+					sum += local;
+				});
+			}
+			for (auto& thread : threads) thread.join();
+		});
+
+		checksum += sum;
+		return ms;
+	}
+
+	// entities being created and destroyed
+	template<typename Map>
+	double churn(memory::Allocator& alloc, uint32 live_count, uint32 rounds, uint64& checksum)
+	{
+		Map mapping(alloc);
+
+		return measure_ms([&]()
+		{
+			uint32 next = 0;
+			for (uint32 r = 0; r < rounds; r++)
+			{
+				mapping.set(next, (int32)r);
+				if (next >= live_count) mapping.remove(next - live_count);
+				next++;
+			}
+			checksum += mapping.size();
+		});
+	}
+
+	// worst single insert while filling a map, full vs incremental rehash
+	double max_insert_latency(memory::Allocator& alloc, uint32 count, bool incremental)
+	{
+		HashMap<uint64, int32> mapping(alloc);
+		mapping.set_incremental_rehash(incremental);
+
+		// the entry array keeps its capacity over clear(), the refill only measures the index growth
+		for (uint32 i = 0; i < count; i++) mapping.set(i, (int32)i);
+		mapping.clear();
+
+		double max_ms = 0;
+		for (uint32 i = 0; i < count; i++)
+		{
+			double ms = measure_ms([&]() { mapping.set(i, (int32)i); });
+			if (ms > max_ms) max_ms = ms;
+		}
+		return max_ms;
+	}
+
+	void report(const char* name, double chained, double flat)
+	{
+		std::cout << "   " << name << "  HashMap: " << chained << "ms  FlatHashMap: " << flat << "ms\n";
+	}
+}
+
+void hashmap_benchmark()
+{
+	std::cout << "<hashmap_benchmark_begin>" << std::endl;
+
+	memory::Mallocator alloc;
+	uint64 checksum = 0;
+
+	for (uint32 entity_count : { 1000u, 100000u, 1000000u })
+	{
+		std::vector<uint32> order(entity_count);
+		for (uint32 i = 0; i < entity_count; i++) order[i] = i;
+		uint32 rounds = 10000000 / entity_count;
+
+		std::cout << entity_count << " entities\n";
+		report("get_component, entity order   ",
+			component_lookup<HashMap<uint64, int32>>(alloc, order, rounds, checksum),
+			component_lookup<FlatHashMap<int32>>(alloc, order, rounds, checksum));
+
+		std::shuffle(order.begin(), order.end(), std::mt19937(entity_count));
+		report("get_component, scattered      ",
+			component_lookup<HashMap<uint64, int32>>(alloc, order, rounds, checksum),
+			component_lookup<FlatHashMap<int32>>(alloc, order, rounds, checksum));
+
+		std::cout << "   get_component, scattered batch  HashMap: "
+			<< component_lookup_batch(alloc, order, rounds, checksum) << "ms\n";
+		std::cout << "   get_component, scattered        SparseSet: "
+			<< component_lookup_sparse(alloc, order, rounds, checksum) << "ms\n";
+
+		report("create/destroy churn          ",
+			churn<HashMap<uint64, int32>>(alloc, entity_count, 2000000, checksum),
+			churn<FlatHashMap<int32>>(alloc, entity_count, 2000000, checksum));
+
+		std::cout << "   worst insert  full rehash: " << max_insert_latency(alloc, entity_count, false)
+			<< "ms  incremental: " << max_insert_latency(alloc, entity_count, true) << "ms\n";
+	}
+
+	std::cout << "300 textures\n";
+	report("TextureManager lookup         ",
+		texture_lookup<HashMap<uint64, TextureInfo>>(alloc, 10000000, checksum),
+		texture_lookup<FlatHashMap<TextureInfo>>(alloc, 10000000, checksum));
+
+	{
+		const uint32 THREAD_COUNT = 4;
+		HashMap<uint64, TextureInfo> locked(alloc);
+		ConcurrentHashMap<TextureInfo> concurrent(alloc);
+		std::mutex mutex;
+		for (uint32 i = 1; i <= 300; i++)
+		{
+			locked.set(i, TextureInfo{ i, 256, 256, 1, 1, 9 });
+			concurrent.set(i, TextureInfo{ i, 256, 256, 1, 1, 9 });
+		}
+
+		double locked_ms = parallel_texture_lookup(THREAD_COUNT, 2500000, checksum, [&](uint64 handle)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto entry = locked.lookup(handle);
+			return entry ? &entry->value() : nullptr;
+		});
+		double concurrent_ms = parallel_texture_lookup(THREAD_COUNT, 2500000, checksum, [&](uint64 handle)
+		{
+			return concurrent.lookup(handle);
+		});
+		std::cout << "   TextureManager lookup, " << THREAD_COUNT << " threads  HashMap + mutex: " << locked_ms
+			<< "ms  ConcurrentHashMap: " << concurrent_ms << "ms\n";
+
+		// with fewer cores the threads take turns, neither contention nor reader scaling is measured
+		uint32 cores = std::thread::hardware_concurrency();
+		if (cores < THREAD_COUNT)
+		{
+			std::cout << "   (only " << cores << " cores, the threaded numbers are not meaningful)\n";
+		}
+	}
+
+	std::cout << "(checksum " << checksum << ")\n";
+	std::cout << "<hashmap_benchmark_end>" << "\n" << std::endl;
+}
@@ -0,0 +1,274 @@
+#include "benchmark.hpp"
+
+#include "arc/common.hpp"
+#include "arc/memory/Allocator.hpp"
+#include "arc/collections/MpmcQueue.inl"
+#include "arc/collections/Queue.inl"
+#include "arc/collections/SpscQueue.inl"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace arc;
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	template<uint32 SIZE>
+	struct Message
+	{
+		uint64 id;
+		char   payload[SIZE - sizeof(uint64)];
+	};
+
+	const uint32 MESSAGE_COUNT = 4000000;
+	const uint32 CAPACITY = 1024;
+	const uint32 BATCH_SIZE = 32;
+
+	// runs producer and consumer on two threads, returns messages per second
+	template<typename P, typename C>
+	double measure_rate(P producer, C consumer)
+	{
+		auto begin = Clock::now();
+		std::thread consumer_thread(consumer);
+		producer();
+		consumer_thread.join();
+		auto end = Clock::now();
+		return MESSAGE_COUNT / std::chrono::duration<double>(end - begin).count();
+	}
+
+	// the logic thread handing messages one at a time
+	template<typename M>
+	double spsc_single(memory::Allocator& alloc, uint64& checksum)
+	{
+		SpscQueue<M> queue(&alloc, CAPACITY);
+		return measure_rate([&]()
+		{
+			M m = {};
+			for (uint32 i = 0; i < MESSAGE_COUNT; i++)
+			{
+				m.id = i;
+				while (!queue.push(m)) std::this_thread::yield();
+			}
+		}, [&]()
+		{
+			M m;
+			for (uint32 i = 0; i < MESSAGE_COUNT; i++)
+			{
+				while (!queue.pop(m)) std::this_thread::yield();
+				checksum += m.id;
+			}
+		});
+	}
+
+	// both sides move BATCH_SIZE messages per atomic store
+	template<typename M>
+	double spsc_batch(memory::Allocator& alloc, uint64& checksum)
+	{
+		SpscQueue<M> queue(&alloc, CAPACITY);
+		return measure_rate([&]()
+		{
+			M batch[BATCH_SIZE] = {};
+			for (uint32 i = 0; i < MESSAGE_COUNT; i += BATCH_SIZE)
+			{
+				for (uint32 k = 0; k < BATCH_SIZE; k++) batch[k].id = i + k;
+
+				uint32 pushed = 0;
+				while (pushed < BATCH_SIZE)
+				{
+					uint32 n = queue.push_n(batch + pushed, BATCH_SIZE - pushed);
+					if (n == 0) std::this_thread::yield();
+					pushed += n;
+				}
+			}
+		}, [&]()
+		{
+			M batch[BATCH_SIZE];
+			for (uint32 i = 0; i < MESSAGE_COUNT;)
+			{
+				uint32 n = queue.pop_n(batch, BATCH_SIZE);
+				if (n == 0) std::this_thread::yield();
+				for (uint32 k = 0; k < n; k++) checksum += batch[k].id;
+				i += n;
+			}
+		});
+	}
+
+	// what the queue replaces: arc::Queue behind a mutex
+	template<typename M>
+	double locked_queue(memory::Allocator& alloc, uint64& checksum)
+	{
+		Queue<M> queue(&alloc, CAPACITY);
+		std::mutex mutex;
+		return measure_rate([&]()
+		{
+			M m = {};
+			for (uint32 i = 0; i < MESSAGE_COUNT; i++)
+			{
+				m.id = i;
+				for (;;)
+				{
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						if (queue.size() < CAPACITY) { queue.push_back(m); break; }
+					}
+					std::this_thread::yield();
+				}
+			}
+		}, [&]()
+		{
+			for (uint32 i = 0; i < MESSAGE_COUNT; i++)
+			{
+				for (;;)
+				{
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						if (!queue.empty()) { checksum += queue.pop_front().id; break; }
+					}
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	// producers split MESSAGE_COUNT between them, consumers pop until all were consumed
+	template<typename Push, typename Pop>
+	double measure_rate(uint32 producer_count, uint32 consumer_count, Push push, Pop pop, uint64& checksum)
+	{
+		std::atomic<uint32> consumed(0);
+		std::atomic<uint64> sum(0);
+
+		auto begin = Clock::now();
+		std::vector<std::thread> threads;
+		for (uint32 p = 0; p < producer_count; p++)
+		{
+			uint32 first = MESSAGE_COUNT / producer_count * p;
+			uint32 last = p + 1 == producer_count ? MESSAGE_COUNT : first + MESSAGE_COUNT / producer_count;
+			threads.emplace_back([=]() { push(first, last); });
+		}
+		for (uint32 c = 0; c < consumer_count; c++)
+		{
+			threads.emplace_back([&]()
+			{
+				uint64 local_sum = 0;
+				while (consumed.load(std::memory_order_relaxed) < MESSAGE_COUNT)
+				{
+					uint32 n = pop(local_sum);
+					if (n == 0) std::this_thread::yield();
+					consumed.fetch_add(n, std::memory_order_relaxed);
+				}
+				sum.fetch_add(local_sum);
+			});
+		}
+		for (auto& t : threads) t.join();
+		auto end = Clock::now();
+
+		checksum += sum.load();
+		return MESSAGE_COUNT / std::chrono::duration<double>(end - begin).count();
+	}
+
+	// task distribution, one task handed over per call or BATCH_SIZE with the bulk variants
+	double mpmc(memory::Allocator& alloc, uint32 producer_count, uint32 consumer_count, bool bulk, uint64& checksum)
+	{
+		MpmcQueue<uint64> queue(&alloc, CAPACITY);
+		return measure_rate(producer_count, consumer_count, [&](uint32 first, uint32 last)
+		{
+			uint64 batch[BATCH_SIZE];
+			for (uint32 i = first; i < last;)
+			{
+				uint32 n = bulk ? std::min(BATCH_SIZE, last - i) : 1;
+				for (uint32 k = 0; k < n; k++) batch[k] = i + k;
+
+				uint32 pushed = bulk ? queue.try_push_n(batch, n) : (queue.try_push(batch[0]) ? 1 : 0);
+				if (pushed == 0) std::this_thread::yield();
+				i += pushed;
+			}
+		}, [&](uint64& local_sum) -> uint32
+		{
+			uint64 batch[BATCH_SIZE];
+			uint32 n = bulk ? queue.try_pop_n(batch, BATCH_SIZE) : (queue.try_pop(batch[0]) ? 1 : 0);
+			for (uint32 k = 0; k < n; k++) local_sum += batch[k];
+			return n;
+		}, checksum);
+	}
+
+	double mpmc_locked(memory::Allocator& alloc, uint32 producer_count, uint32 consumer_count, uint64& checksum)
+	{
+		Queue<uint64> queue(&alloc, CAPACITY);
+		std::mutex mutex;
+		return measure_rate(producer_count, consumer_count, [&](uint32 first, uint32 last)
+		{
+			for (uint32 i = first; i < last;)
+			{
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (queue.size() < CAPACITY) { queue.push_back(i); i++; continue; }
+				}
+				std::this_thread::yield();
+			}
+		}, [&](uint64& local_sum) -> uint32
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (queue.empty()) return 0;
+			local_sum += queue.pop_front();
+			return 1;
+		}, checksum);
+	}
+
+	template<uint32 SIZE>
+	void run(memory::Allocator& alloc, uint64& checksum)
+	{
+		using M = Message<SIZE>;
+		double locked = locked_queue<M>(alloc, checksum);
+		double single = spsc_single<M>(alloc, checksum);
+		double batch = spsc_batch<M>(alloc, checksum);
+
+		std::cout << "   " << SIZE << " byte messages  Queue+mutex: " << locked / 1e6
+			<< "M/s  SpscQueue: " << single / 1e6 << "M/s  SpscQueue batched: " << batch / 1e6 << "M/s\n";
+	}
+}
+
+void spsc_queue_benchmark()
+{
+	std::cout << "<spsc_queue_benchmark_begin>" << std::endl;
+
+	memory::Mallocator alloc;
+	uint64 checksum = 0;
+
+	run<16>(alloc, checksum);
+	run<64>(alloc, checksum);
+	run<256>(alloc, checksum);
+
+	std::cout << "(checksum " << checksum << ")\n";
+	std::cout << "<spsc_queue_benchmark_end>" << "\n" << std::endl;
+}
+
+void mpmc_queue_benchmark()
+{
+	std::cout << "<mpmc_queue_benchmark_begin>" << std::endl;
+
+	memory::Mallocator alloc;
+	uint64 checksum = 0;
+
+	uint32 thread_pairs[][2] = { { 1, 1 }, { 2, 2 }, { 4, 4 }, { 1, 4 }, { 4, 1 } };
+	for (auto& pair : thread_pairs)
+	{
+		uint32 producers = pair[0];
+		uint32 consumers = pair[1];
+		double locked = mpmc_locked(alloc, producers, consumers, checksum);
+		double single = mpmc(alloc, producers, consumers, false, checksum);
+		double bulk = mpmc(alloc, producers, consumers, true, checksum);
+
+		std::cout << "   " << producers << " producers " << consumers << " consumers  Queue+mutex: " << locked / 1e6
+			<< "M/s  MpmcQueue: " << single / 1e6 << "M/s  MpmcQueue bulk: " << bulk / 1e6 << "M/s\n";
+	}
+
+	std::cout << "(checksum " << checksum << ")\n";
+	std::cout << "<mpmc_queue_benchmark_end>" << "\n" << std::endl;
+}
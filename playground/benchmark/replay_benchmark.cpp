@@ -0,0 +1,226 @@
+#include "benchmark.hpp"
+
+#include "arc/common.hpp"
+#include "arc/memory/Allocator.hpp"
+#include "arc/memory/LinearAllocator.hpp"
+#include "arc/memory/SlabAllocator.hpp"
+#include "arc/memory/TraceAllocator.hpp"
+#include "arc/memory/TrackingAllocator.hpp"
+#include "arc/collections/Array.inl"
+#include "arc/collections/HashMap.inl"
+#include "arc/io/FileStream.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+using namespace arc;
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+	using Event = memory::TraceAllocator::Event;
+	using Op = memory::TraceAllocator::Op;
+
+	uint64 resident_bytes()
+	{
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+		return counters.WorkingSetSize;
+#else
+		FILE* file = fopen("/proc/self/statm", "r");
+		if (file == nullptr) return 0;
+		unsigned long pages = 0, resident = 0;
+		int n = fscanf(file, "%lu %lu", &pages, &resident);
+		fclose(file);
+		return n == 2 ? (uint64)resident * (uint64)sysconf(_SC_PAGESIZE) : 0;
+#endif
+	}
+
+	// container growth and short lived blocks, used when no trace file is given
+	void record_synthetic_trace(memory::Allocator& alloc)
+	{
+		for (uint32 r = 0; r < 50; r++)
+		{
+			Array<uint32> arrays[64];
+			for (auto& a : arrays) a.initialize(&alloc);
+			HashMap<uint64, uint32> map(alloc);
+
+			uint32 rnd = 12345 + r;
+			void* live[256] = {};
+			for (uint32 i = 0; i < 1024; i++)
+			{
+				rnd = rnd * 1103515245 + 12345;
+				arrays[i % 64].push_back(i);
+				if (i % 4 == 0) map.set(rnd, i);
+
+				uint32 slot = (rnd >> 8) % 256;
+				alloc.free(live[slot]);
+				live[slot] = alloc.allocate(8 + (rnd >> 16) % 120, 8);
+			}
+			for (auto p : live) alloc.free(p);
+		}
+	}
+
+	struct Result
+	{
+		double milliseconds;
+		uint64 peak_requested;		// bytes live at once, as recorded in the trace
+		uint64 peak_resident;		// growth of the resident set during the replay
+		uint64 failed;
+	};
+
+	// replays the events in recorded order on the calling thread, the thread of an event is ignored
+	Result replay(const Array<Event>& events, uint32 allocation_count, memory::Allocator& alloc, bool sample_resident)
+	{
+		std::vector<void*> blocks(allocation_count, nullptr);
+		std::vector<uint32> sizes(allocation_count, 0);
+
+		Result result = {};
+		uint64 live = 0;
+		uint64 resident_base = sample_resident ? resident_bytes() : 0;
+
+		auto begin = Clock::now();
+		for (uint32 i = 0; i < events.size(); i++)
+		{
+			const Event& e = events[i];
+			if (e.op == Op::ALLOCATE)
+			{
+				void* data = alloc.allocate(e.size, 1u << e.align_shift);
+				if (data == nullptr) { result.failed++; continue; }
+
+				if (e.size > 0) *(uint8*)data = 0;	// touch the block like its owner would
+				blocks[e.id] = data;
+				sizes[e.id] = e.size;
+				live += e.size;
+				if (live > result.peak_requested) result.peak_requested = live;
+			}
+			else if (blocks[e.id] != nullptr)
+			{
+				alloc.free(blocks[e.id]);
+				blocks[e.id] = nullptr;
+				live -= sizes[e.id];
+			}
+
+			if (sample_resident && (i & 4095) == 0)
+			{
+				uint64 resident = resident_bytes();
+				if (resident > resident_base && resident - resident_base > result.peak_resident)
+				{
+					result.peak_resident = resident - resident_base;
+				}
+			}
+		}
+		auto end = Clock::now();
+
+		// release whatever the trace left alive
+		for (auto data : blocks) if (data != nullptr) alloc.free(data);
+
+		result.milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+		return result;
+	}
+
+	uint32 recorded_thread_count(const Array<Event>& events)
+	{
+		bool seen[256] = {};
+		uint32 count = 0;
+		for (auto& e : events)
+		{
+			if (!seen[e.thread]) count++;
+			seen[e.thread] = true;
+		}
+		return count;
+	}
+
+	using Factory = std::function<memory::Allocator*(memory::Allocator* parent)>;
+
+	void run(const char* name, const Array<Event>& events, uint32 allocation_count, const Factory& create, bool has_parent)
+	{
+		memory::Mallocator malloc;
+
+		// timed pass
+		memory::Allocator* alloc = create(&malloc);
+		Result timed = replay(events, allocation_count, *alloc, false);
+		malloc.destroy(alloc);
+
+		// footprint pass, the tracking allocator sees what the allocator requests from its parent
+		memory::TrackingAllocator tracking(&malloc, name);
+		alloc = create(&tracking);
+		Result measured = replay(events, allocation_count, *alloc, true);
+		uint64 footprint = tracking.stats().peak_bytes;
+		tracking.destroy(alloc);
+
+		double ops = events.size() / (timed.milliseconds / 1000.0);
+		std::cout << "   " << name << ": " << timed.milliseconds << "ms  " << (uint64)ops << " ops/s"
+			<< "  peak RSS +" << measured.peak_resident / 1024 << "KB";
+		if (has_parent && measured.peak_requested > 0)
+		{
+			std::cout << "  fragmentation " << (double)footprint / measured.peak_requested
+				<< " (" << footprint / 1024 << "KB for " << measured.peak_requested / 1024 << "KB)";
+		}
+		if (timed.failed > 0) std::cout << "  failed " << timed.failed;
+		std::cout << "\n";
+	}
+}
+
+void allocation_replay_benchmark(const char* trace_path)
+{
+	std::cout << "<allocation_replay_benchmark_begin>" << std::endl;
+
+	memory::Mallocator malloc;
+	Array<Event> loaded_events(malloc);
+	uint32 allocation_count = 0;
+
+	bool loaded = false;
+	if (trace_path != nullptr)
+	{
+		io::FileReadStream file;
+		loaded = file.open(StringView(trace_path, 0, (uint32)strlen(trace_path))) && memory::TraceAllocator::load(file, loaded_events, allocation_count);
+		if (!loaded) std::cout << "could not load trace " << trace_path << "\n";
+	}
+
+	memory::TraceAllocator trace(&malloc, &malloc);
+	if (!loaded)
+	{
+		record_synthetic_trace(trace);
+		allocation_count = trace.allocation_count();
+	}
+	const Array<Event>& events = loaded ? loaded_events : trace.events();
+
+	std::cout << (loaded ? trace_path : "synthetic trace") << ": " << events.size() << " events, "
+		<< allocation_count << " allocations\n";
+
+	uint32 thread_count = recorded_thread_count(events);
+	if (thread_count > 1)
+	{
+		std::cout << "   recorded on " << thread_count << " threads, replayed on one thread in recorded order;"
+			<< " contention and per-thread caches are not measured\n";
+	}
+
+	run("Mallocator", events, allocation_count, [](memory::Allocator* parent) -> memory::Allocator*
+	{
+		return parent->create<memory::Mallocator>();
+	}, false);
+	run("SlabAllocator", events, allocation_count, [](memory::Allocator* parent) -> memory::Allocator*
+	{
+		return parent->create<memory::SlabAllocator>(parent);
+	}, true);
+	run("LinearAllocator", events, allocation_count, [](memory::Allocator* parent) -> memory::Allocator*
+	{
+		return parent->create<memory::LinearAllocator>(parent, 1024 * 1024);
+	}, true);
+
+	std::cout << "<allocation_replay_benchmark_end>" << "\n" << std::endl;
+}
@@ -84,7 +84,7 @@ namespace arc {
 		Handle add_component(entity2::Handle h);
 		Handle get_component(entity2::Handle h);
 	private:
-		HashMap<int32>			m_mapping;
+		HashMap<uint64, int32>			m_mapping;
 		Array<Data>				m_data;
 		Array<entity2::Handle>	m_entities;
 	};*/
@@ -122,7 +122,7 @@ namespace arc {
 		Array<vec4>				m_data_color;
 		Array<uint32>			m_data_mesh_id;
 
-		HashMap<int32>			m_mapping;
+		HashMap<uint64, int32>			m_mapping;
 		Array<entity2::Handle>	m_entities;
 	private:
 		friend class TestComponent2Handle;
@@ -35,8 +35,8 @@ namespace arc { namespace engine
 			, frame_begin_callbacks(longterm_allocator())
 		{}
 
-		HashMap<Subsystem*> subsystem_registry;
-		HashMap<std::function<void(double)>> frame_begin_callbacks;
+		HashMap<uint64, Subsystem*> subsystem_registry;
+		HashMap<StringHash, std::function<void(double)>> frame_begin_callbacks;
 	};
 
 	EngineState* _state = nullptr;
@@ -60,12 +60,21 @@ namespace arc { namespace engine
 		SDL_Quit();
 	}
 
+	static memory::Allocator* _longterm_allocator = nullptr;
+
 	memory::Allocator& longterm_allocator()
 	{
 		static memory::Mallocator malloc;
+		if (_longterm_allocator != nullptr) return *_longterm_allocator;
 		return malloc;
 	}
 
+	void set_longterm_allocator(memory::Allocator* alloc)
+	{
+		ARC_ASSERT(_state == nullptr, "engine: the longterm allocator has to be set before initialization");
+		_longterm_allocator = alloc;
+	}
+
 	void _init_sdl2(const Config& config)
 	{
 		// init SDL
@@ -249,7 +258,7 @@ namespace arc { namespace engine
 
 		auto& reg = _state->frame_begin_callbacks;
 		bool added;
-		reg.get(name.value(), cb, added);
+		reg.get(name, cb, added);
 		ARC_ASSERT(added, "A frame_begin callback with this name allready exists.");
 
 		return added;
@@ -260,7 +269,7 @@ namespace arc { namespace engine
 		ARC_ASSERT(_state != nullptr, "arc::engine is not initialized");
 
 		auto& reg = _state->frame_begin_callbacks;
-		bool removed = reg.remove(name.value());
+		bool removed = reg.remove(name);
 		ARC_ASSERT(removed, "A frame_begin callback with this name is not present.");
 
 		return removed;
@@ -19,6 +19,10 @@ namespace arc
 
 			bool window_hidden = false;
 			bool fullscreen = false;
+
+			// SimpleMainLoop records the renderer allocations with a memory::TraceAllocator
+			// and saves them to this file on shutdown, see allocation_replay_benchmark()
+			const char* allocation_trace_path = nullptr;
 		};
 
 		void initialize(const Config& config);
@@ -31,6 +35,10 @@ namespace arc
 
 		memory::Allocator& longterm_allocator();
 
+		// Replaces the longterm allocator, e.g. with a memory::TrackingAllocator.
+		// Has to be called before initialize(), nullptr restores the default.
+		void set_longterm_allocator(memory::Allocator* alloc);
+
 		// Updates /////////////////////////////////////////////
 
 		bool register_frame_begin_cb(StringHash name, const std::function<void(double)>& cb);
@@ -1,6 +1,7 @@
 #include "CallbackManager.hpp"
 
 #include "arc/collections/HashMap.inl"
+#include "arc/collections/SmallArray.inl"
 
 namespace arc { namespace engine {
 
@@ -10,11 +11,11 @@ namespace arc { namespace engine {
 
 	bool CallbackManager::register_callback(StringHash32 category, StringView name, std::function<void()> cb)
 	{
-		auto name_hash = string_hash32(name);
-		auto& entry = m_callbacks.get(category.value(), Array<Callback>(*m_alloc));
+		auto name_hash = NameHasher::hash(name);
+		auto& entry = m_callbacks.get(category, CallbackList(*m_alloc));
 
 		// check if a callback with the same name is already present in this category
-		for (auto& c : entry.value()) { if (c.name_hash == name_hash) return false; }
+		for (auto& c : entry.value()) { if (c.name_hash == name_hash && NameHasher::equal(c.name, name)) return false; }
 		
 		entry.value().push_back(Callback{ name_hash, name, cb });
 		return true;
@@ -22,8 +23,8 @@ namespace arc { namespace engine {
 
 	bool CallbackManager::unregister_callback(StringHash32 category, StringView name)
 	{
-		auto name_hash = string_hash32(name);
-		auto entry = m_callbacks.lookup(category.value());
+		auto name_hash = NameHasher::hash(name);
+		auto entry = m_callbacks.lookup(category);
 		if (!entry) return false;
 
 		// look for a callback with the requested name in this category
@@ -32,7 +33,7 @@ namespace arc { namespace engine {
 		{
 			// if we find it, remove it from the list and return
 			auto& e = list[i];
-			if (e.name_hash == name_hash)
+			if (e.name_hash == name_hash && NameHasher::equal(e.name, name))
 			{
 				list[i] = list.back();
 				list.pop_back();
@@ -45,7 +46,7 @@ namespace arc { namespace engine {
 
 	void CallbackManager::call_callbacks(StringHash32 category)
 	{
-		auto entry = m_callbacks.lookup(category.value());
+		auto entry = m_callbacks.lookup(category);
 		if (!entry) return;
 
 		for (auto& c : entry->value()) c.function();
@@ -5,6 +5,7 @@
 #include "arc/hash/StringHash.hpp"
 
 #include "arc/collections/HashMap.hpp"
+#include "arc/collections/SmallArray.hpp"
 
 #include <functional>
 
@@ -20,13 +21,17 @@ namespace arc { namespace engine {
 	public:
 		void call_callbacks(StringHash32 category);
 	private:
+		// names are compared in full, a hash match alone may be a collision
+		using NameHasher = Hasher<String>;
 		struct Callback
 		{
-			StringHash32 name_hash;
+			uint64 name_hash;
 			String name;
 			std::function<void()> function;
 		};
-		HashMap<Array<Callback>> m_callbacks;
+		using CallbackList = SmallArray<Callback, 4>;
+
+		HashMap<StringHash32, CallbackList> m_callbacks;
 		memory::Allocator* m_alloc;
 	};
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <cstring>
 #include <chrono>
 #include <iostream>
 
@@ -8,6 +9,9 @@
 #include "arc/renderer/Renderer_GL44.hpp"
 #include "arc/gl/functions.hpp"
 #include "arc/collections/Array.inl"
+#include "arc/memory/TrackingAllocator.hpp"
+#include "arc/memory/TraceAllocator.hpp"
+#include "arc/io/FileStream.hpp"
 
 #include "../engine.hpp"
 #include "../input/KeyboardState.hpp"
@@ -20,7 +24,9 @@ namespace arc
 		SimpleMainLoop() : SimpleMainLoop(engine::Config(), renderer::Config()) {}
 
 		SimpleMainLoop(const engine::Config& engine_config, const renderer::Config& renderer_config)
-			: m_engine_config(engine_config)
+			: m_trace_allocator(&m_longterm_allocator, &m_longterm_allocator)
+			, m_renderer_allocator(engine_config.allocation_trace_path ? (memory::Allocator*)&m_trace_allocator : &m_longterm_allocator, "renderer")
+			, m_engine_config(engine_config)
 			, m_renderer_config(renderer_config)
 		{
 			// initialize logging
@@ -32,7 +38,7 @@ namespace arc
 
 			// initialize renderer
 			renderer::AllocatorConfig alloc_config;
-			alloc_config.longterm_allocator = &m_longterm_allocator;
+			alloc_config.longterm_allocator = &m_renderer_allocator;
 			m_renderer = m_longterm_allocator.create<renderer::Renderer_GL44>(m_renderer_config, alloc_config);
 
 			// initialize keyboard input
@@ -44,6 +50,15 @@ namespace arc
 			m_longterm_allocator.destroy(m_renderer);
 			m_longterm_allocator.destroy(m_keyboard);
 
+			// all renderer memory is freed, the trace is complete
+			const char* trace_path = m_engine_config.allocation_trace_path;
+			if (trace_path != nullptr)
+			{
+				io::FileWriteStream file;
+				bool saved = file.open(StringView(trace_path, 0, (uint32)strlen(trace_path))) && m_trace_allocator.save(file);
+				if (!saved) LOG_ERROR("Could not save allocation trace: ", trace_path);
+			}
+
 			engine::shutdown();
 		}
 
@@ -180,8 +195,11 @@ namespace arc
 
 	public:
 		memory::Allocator& longterm_allocator() { return m_longterm_allocator; }
+		memory::TrackingAllocator& renderer_allocator() { return m_renderer_allocator; }
 	protected:
 		arc::memory::Mallocator         m_longterm_allocator;
+		arc::memory::TraceAllocator     m_trace_allocator;		// only in use with engine::Config::allocation_trace_path
+		arc::memory::TrackingAllocator  m_renderer_allocator;
 		arc::log::DefaultLogger	        m_default_logger;
 	protected:
 		engine::Config					m_engine_config;
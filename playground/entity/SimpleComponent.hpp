@@ -2,8 +2,9 @@
 
 #include "entity.hpp"
 
-#include "arc/collections/HashMap.inl"
+#include "arc/collections/SparseSet.inl"
 #include "arc/collections/Array.inl"
+#include "arc/memory/no_alloc.hpp"
 
 namespace arc { namespace entity {
 
@@ -21,11 +22,18 @@ namespace arc { namespace entity {
 	public:
 		HandleT add_component(entity::Handle h);
 		HandleT get_component(entity::Handle h);
+
+		/// Looks up the components of many entities at once.
+		/// Entities without a component get an invalid handle.
+		void get_components(Slice<const entity::Handle> entities, Slice<HandleT> o_components);
+
+		/// Entities owning a component, in the order update_all visits them.
+		Slice<const entity::Handle> entities() const;
 	public:
 		template<typename F>
 		void update_all(F function);
 	protected:
-		HashMap<int32>			m_mapping;
+		SparseSet				m_mapping;		// entity index -> component index
 		Array<DataT>			m_data;
 		Array<entity::Handle>	m_entities;
 		uint32_t				m_count;
@@ -60,7 +68,9 @@ namespace arc { namespace entity {
 	template< typename HandleType, typename DataType>
 	SimpleComponentBackend<HandleType, DataType>::SimpleComponentBackend(memory::Allocator* alloc, uint32 capacity)
 		: m_mapping(*alloc), m_data(*alloc, capacity), m_entities(*alloc, capacity), m_count(0)
-	{}
+	{
+		m_mapping.reserve(capacity);
+	}
 
 	template< typename HandleType, typename DataType>
 	HandleType SimpleComponentBackend<HandleType, DataType>::add_component(entity::Handle h)
@@ -74,7 +84,7 @@ namespace arc { namespace entity {
 		uint32 index = m_count;
 		m_count += 1;
 		m_entities[index] = h;
-		m_mapping.set(h.index(),index);
+		m_mapping.insert(h.index());
 
 		HandleT ch;
 		ch.m_backend = this;
@@ -85,20 +95,39 @@ namespace arc { namespace entity {
 	template< typename HandleType, typename DataType>
 	HandleType SimpleComponentBackend<HandleType, DataType>::get_component(entity::Handle h)
 	{
-		auto entry = m_mapping.lookup(h.index());
-		if (!entry) return HandleT();
+		uint32 index = m_mapping.index_of(h.index());
+		if (index == SparseSet::INVALID_INDEX) return HandleT();
 
 		HandleT ch;
 		ch.m_backend = this;
-		ch.m_index = entry->value();
+		ch.m_index = index;
 		return ch;
 	}
 
 
+	template< typename HandleType, typename DataType>
+	void SimpleComponentBackend<HandleType, DataType>::get_components(Slice<const entity::Handle> entities, Slice<HandleT> o_components)
+	{
+		ARC_ASSERT(o_components.size() >= entities.size(), "output slice is too small");
+
+		// no batching needed, the lookups are independent and don't chase chains
+		for (uint64 i = 0; i < entities.size(); i++)
+		{
+			o_components[i] = get_component(entities[i]);
+		}
+	}
+
+	template< typename HandleType, typename DataType>
+	Slice<const entity::Handle> SimpleComponentBackend<HandleType, DataType>::entities() const
+	{
+		return Slice<const entity::Handle>(m_entities.data(), m_count);
+	}
+
 	template<typename HandleType, typename DataType>
 	template<typename F>
 	void SimpleComponentBackend<HandleType, DataType>::update_all(F function)
 	{
+		ARC_NO_ALLOC_SCOPE("SimpleComponentBackend::update_all");
 		HandleT component;
 		component.m_backend = this;
 
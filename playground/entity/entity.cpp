@@ -7,7 +7,7 @@ namespace arc { namespace entity {
 	Context::Context(memory::Allocator* alloc, uint32 initial_capacity)
 		:  m_allocator(alloc)
 	{
-		m_index_pool.initialize(alloc, initial_capacity, 256, std::numeric_limits<uint32>::max());
+		m_index_pool.initialize(alloc, initial_capacity, Handle::Pool::MAX_CAPACITY, handle_pool::LinearGrowth(256));
 
 		for (auto& ptr : m_component_backends) ptr = nullptr;
 	}
@@ -20,21 +20,21 @@ namespace arc { namespace entity {
 	Handle Context::create_entity()
 	{
 		Handle h;
-		h.m_index = m_index_pool.create();
+		h.m_value = m_index_pool.create();
 		return h;
 	}
 
 	bool Context::destroy_entity(Handle h)
 	{
-		if (!m_index_pool.valid(h.m_index)) return false;
+		if (!m_index_pool.valid(h.m_value)) return false;
 		ARC_NOT_IMPLEMENTED;
-		m_index_pool.release(h.m_index);
+		m_index_pool.release(h.m_value);
 		return true;
 	}
 
 	bool Context::valid(Handle h)
 	{
-		return m_index_pool.valid(h.index());
+		return m_index_pool.valid(h.m_value);
 	}
 
 }}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "arc/util/IndexPool.hpp"
 #include "arc/util/ManualTypeId.hpp"
 #include "arc/collections/Array.hpp"
+#include "arc/collections/HierarchicalBitset.inl"
 
 namespace arc { namespace entity {
 
@@ -12,10 +13,12 @@ namespace arc { namespace entity {
 	struct Handle
 	{
 	public:
-		inline uint32 index() { return m_index; }
+		using Pool = HandlePool32<24, 8>;
+	public:
+		inline uint32 index() const { return Pool::index(m_value); }
+		inline uint32 generation() const { return Pool::generation(m_value); }
 	private:
-		uint32 m_index : 24;
-		uint32 m_generation : 8;
+		uint32 m_value;
 	private:
 		friend class entity::Context;
 	};
@@ -48,11 +51,23 @@ namespace arc { namespace entity {
 		template<typename T>
 		typename T::Handle get_component(entity::Handle h);
 
+		template<typename T>
+		void get_components(Slice<const entity::Handle> entities, Slice<typename T::Handle> o_components);
+
 		template<typename T>
 		bool has_component(entity::Handle h);
 
 		template<typename T>
 		bool remove_component(entity::Handle h);
+	public:
+		/// Entities that have a component of type T, one bit per entity index.
+		template<typename T>
+		const HierarchicalBitset& component_mask();
+
+		/// Calls function(entity::Handle) for every entity that has all components Ts,
+		/// in ascending index order. Entity ranges without any match are skipped.
+		template<typename... Ts, typename F>
+		void for_each_entity_with(F function);
 	private:
 		struct CompTContext
 		{
@@ -66,17 +81,14 @@ namespace arc { namespace entity {
 			CompTContext::Type m_type;
 			uint32 m_index;
 		};
-		struct EntityData
-		{
-			uint16 m_component_count = 0;
-		};
 
 	private:
 		uint32 m_index;
-		IndexPool32 m_index_pool;
+		Handle::Pool m_index_pool;
 		memory::Allocator* m_allocator = nullptr;
 
 		ComponentBackend* m_component_backends[CompTContext::Last + 1];
+		HierarchicalBitset m_component_masks[CompTContext::Last + 1];
 	};
 
 
@@ -95,6 +107,7 @@ namespace arc { namespace entity {
 		}
 
 		m_component_backends[type_id] = m_allocator->create<T::Backend>(m_allocator, initial_capacity);
+		m_component_masks[type_id].initialize(m_allocator, initial_capacity);
 		return true;
 	}
 
@@ -102,7 +115,9 @@ namespace arc { namespace entity {
 	typename T::Handle Context::add_component(entity::Handle h)
 	{
 		ARC_ASSERT(valid(h), "invalid entity handle");
-		return get_backend<T>().add_component(h);
+		auto component = get_backend<T>().add_component(h);
+		if (component.valid()) m_component_masks[ManualTypeId<CompTContext, T>::Value()].set(h.index());
+		return component;
 	}
 
 	template<typename T>
@@ -112,6 +127,12 @@ namespace arc { namespace entity {
 		return get_backend<T>().get_component(h);
 	}
 
+	template<typename T>
+	void Context::get_components(Slice<const entity::Handle> entities, Slice<typename T::Handle> o_components)
+	{
+		get_backend<T>().get_components(entities, o_components);
+	}
+
 	template<typename T>
 	typename T::Backend& Context::get_backend()
 	{
@@ -125,6 +146,29 @@ namespace arc { namespace entity {
 
 		return *typed_backend;
 	}
+	template<typename T>
+	const HierarchicalBitset& Context::component_mask()
+	{
+		auto type_id = ManualTypeId<CompTContext, T>::Value();
+		ARC_ASSERT(type_id != CompTContext::Invalid, "Invalid Component Type");
+		ARC_ASSERT(m_component_backends[type_id] != nullptr, "Unregistered Component Type");
+
+		return m_component_masks[type_id];
+	}
+
+	template<typename... Ts, typename F>
+	void Context::for_each_entity_with(F function)
+	{
+		const HierarchicalBitset* masks[] = { &component_mask<Ts>()... };
+
+		HierarchicalBitset::for_each_and(make_slice(masks, sizeof...(Ts)), [&](uint32 index)
+		{
+			entity::Handle h;
+			h.m_value = m_index_pool.handle_at(index);
+			function(h);
+		});
+	}
+
 #if 0 
 	template<typename T>
 	bool Context::remove_component(entity::Handle h)
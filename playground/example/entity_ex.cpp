@@ -47,16 +47,28 @@ void entity_example()
 	std::cout << "position: " << pos.x << " " << pos.y << " " << pos.z << std::endl;
 	std::cout << "color: " << col.r << " " << col.g << " " << col.b << " " << col.a << std::endl;
 
+	// look up the render components of all transformed entities at once
+	auto& transforms = world.get_backend<TransformComponent>();
+	auto entities = transforms.entities();
+	Array<RenderComponent> render_components(alloc, (uint32)entities.size());
+	world.get_components<RenderComponent>(entities, make_slice(render_components.data(), render_components.size()));
+
 	// print all
-	world.get_backend<TransformComponent>().update_all([&world](TransformComponent& self)
+	uint32 index = 0;
+	transforms.update_all([&render_components, &index](TransformComponent& self)
 	{
 		auto pos = self.get_position();
 		std::cout << "<" << pos.x << ", " << pos.y << ", " << pos.z << ">";
 
-		auto eh = self.entity();
-		auto rc = world.get_component<RenderComponent>(eh);
+		auto& rc = render_components[index++];
 		if (rc.valid()) std::cout << (rc.get_visibility() ? " + <visible>" : "+ <invisible>");
 
 		std::cout << "\n";
 	});
+
+	// entities with both components, found through the component masks
+	world.for_each_entity_with<TransformComponent, RenderComponent>([&](entity::Handle h)
+	{
+		std::cout << "entity " << h.index() << " is transformed and rendered\n";
+	});
 }
\ No newline at end of file
@@ -30,6 +30,7 @@ engine::Config g_config;
 
 #include "example/renderer_ex.hpp"
 #include "example/example.hpp"
+#include "benchmark/benchmark.hpp"
 #include "Struct.hpp"
 
 #include "renderer/test.hpp"
@@ -43,6 +44,11 @@ int main(int argc, char** argv)
 	//simple_mesh_example();
 	//renderer_example();
 	//entity_example();
+	//slab_allocator_benchmark();
+	//allocation_replay_benchmark("simple_mesh_ex.atrace"); // recorded with engine::Config::allocation_trace_path
+	//hashmap_benchmark();
+	//spsc_queue_benchmark();
+	//mpmc_queue_benchmark();
 	texture_example();
 
 	std::cout << "<end>" << std::endl;